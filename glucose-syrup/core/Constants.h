@@ -57,3 +57,21 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 // Constants for restarts
 #define LOWER_BOUND_FOR_BLOCKING_RESTART 10000
 
+
+// Keep the metadata of learnt clauses (activity, LBD, flags) in a side table of the
+// ClauseAllocator instead of inside the clauses (see SolverTypes.h)
+//#define LEARNTS_METADATA_TABLE
+
+// Pack the reason, level, value and 'seen' flag of each variable in one record instead of separate
+// arrays, so that conflict analysis reads one cache line per literal (see Solver.h)
+//#define PACKED_VARDATA
+
+// Software prefetching in propagate(): watch lists of the next literals on the trail, and clauses
+// of the watchers ahead whose blocker is not true (distances in literals / watchers)
+#define PREFETCH_PROPAGATION
+#define PREFETCH_TRAIL_DISTANCE 1
+#define PREFETCH_WATCH_DISTANCE 4
+
+// Time the main phases of the solver (propagate, analyze, reduceDB, simplify, garbage collection,
+// elimination, parallel import/export), reported with the statistics (see PhaseTimers.h)
+//#define PROFILE_PHASES
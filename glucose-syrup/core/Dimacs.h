@@ -44,17 +44,55 @@ static void readClause(B& in, Solver& S, vec<Lit>& lits) {
     }
 }
 
+// Reads the literals of a cardinality constraint of the CNF+ format (as MiniCard), ended by
+// '<= k' or '>= k' instead of '0' (an optional '0' may follow on the same line). Returns the
+// constraint as 'at most k' ('lits' are negated for '>='), or -1 for a plain clause.
+template<class B, class Solver>
+static int readConstraint(B& in, Solver& S, vec<Lit>& lits) {
+    int     parsed_lit, var;
+    lits.clear();
+    for (;;){
+        skipWhitespace(in);
+        if (*in == '<' || *in == '>'){
+            bool atleast = *in == '>';
+            ++in;
+            if (*in != '=') printf("PARSE ERROR! Unexpected char: %c\n", *in), exit(3);
+            ++in;
+            int k = parseInt(in);
+            while (*in == ' ' || *in == '\t') ++in;
+            if (*in == '0') ++in;
+            if (atleast){
+                for (int i = 0; i < lits.size(); i++)
+                    lits[i] = ~lits[i];
+                k = lits.size() - k;
+            }
+            if (k < 0){ // unsatisfiable: at least one more literal than there are
+                lits.clear();
+                return -1; }
+            return k;
+        }
+        parsed_lit = parseInt(in);
+        if (parsed_lit == 0) return -1;
+        var = abs(parsed_lit)-1;
+        while (var >= S.nVars()) S.newVar();
+        lits.push( (parsed_lit > 0) ? mkLit(var) : ~mkLit(var) );
+    }
+}
+
 template<class B, class Solver>
 static void parse_DIMACS_main(B& in, Solver& S) {
     vec<Lit> lits;
     int vars    = 0;
     int clauses = 0;
     int cnt     = 0;
+    bool cardinality = false; // "p cnf+": CNF with cardinality constraints
     for (;;){
         skipWhitespace(in);
         if (*in == EOF) break;
         else if (*in == 'p'){
             if (eagerMatch(in, "p cnf")){
+                cardinality = *in == '+';
+                if (cardinality) ++in;
                 vars    = parseInt(in);
                 clauses = parseInt(in);
                 // SATRACE'06 hack
@@ -67,8 +105,14 @@ static void parse_DIMACS_main(B& in, Solver& S) {
             skipLine(in);
         else{
             cnt++;
-            readClause(in, S, lits);
-            S.addClause_(lits); }
+            if (!cardinality){
+                readClause(in, S, lits);
+                S.addClause_(lits);
+            }else{
+                int k = readConstraint(in, S, lits);
+                if (k < 0) S.addClause_(lits);
+                else       S.addAtMost_(lits, k);
+            } }
     }
     if (vars != S.nVars())
         fprintf(stderr, "WARNING! DIMACS header mismatch: wrong number of variables.\n");
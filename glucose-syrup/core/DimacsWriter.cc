@@ -0,0 +1,131 @@
+/**************************************************************************************[DimacsWriter.cc]
+ Glucose -- Copyright (c) 2009-2014, Gilles Audemard, Laurent Simon
+                                CRIL - Univ. Artois, France
+                                LRI  - Univ. Paris Sud, France (2009-2013)
+                                Labri - Univ. Bordeaux, France
+
+ Syrup (Glucose Parallel) -- Copyright (c) 2013-2014, Gilles Audemard, Laurent Simon
+                                CRIL - Univ. Artois, France
+                                Labri - Univ. Bordeaux, France
+
+Glucose sources are based on MiniSat (see below MiniSat copyrights). Permissions and copyrights of
+Glucose (sources until 2013, Glucose 3.0, single core) are exactly the same as Minisat on which it 
+is based on. (see below).
+
+Glucose-Syrup sources are based on another copyright. Permissions and copyrights for the parallel
+version of Glucose-Syrup (the "Software") are granted, free of charge, to deal with the Software
+without restriction, including the rights to use, copy, modify, merge, publish, distribute,
+sublicence, and/or sell copies of the Software, and to permit persons to whom the Software is 
+furnished to do so, subject to the following conditions:
+
+- The above and below copyrights notices and this permission notice shall be included in all
+copies or substantial portions of the Software;
+- The parallel version of Glucose (all files modified since Glucose 3.0 releases, 2013) cannot
+be used in any competitive event (sat competitions/evaluations) without the express permission of 
+the authors (Gilles Audemard / Laurent Simon). This is also the case for any competitive event
+using Glucose Parallel as an embedded SAT engine (single core or not).
+
+
+--------------- Original Minisat Copyrights
+
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "mtl/XAlloc.h"
+#include "core/DimacsWriter.h"
+
+using namespace Glucose;
+
+//=================================================================================================
+// Constructor/Destructor:
+
+
+DimacsWriter::DimacsWriter(bool bin, int size) :
+    out(NULL)
+  , gz(NULL)
+  , own(false)
+  , binary(bin)
+  , failed(false)
+  , buffer_size(size)
+  , buf(NULL)
+  , pos(0)
+{
+    buf = (char*)xrealloc(NULL, buffer_size);
+}
+
+
+DimacsWriter::~DimacsWriter()
+{
+    close();
+    free(buf);
+}
+
+
+//=================================================================================================
+// Output:
+
+
+bool DimacsWriter::open(const char* file)
+{
+    close();
+    size_t len = strlen(file);
+    if (len > 3 && strcmp(file + len - 3, ".gz") == 0)
+        gz = gzopen(file, "wb1");  // (fastest level: the files are written often, read rarely)
+    else
+        out = fopen(file, "wb");
+    own = true;
+    failed = false;
+    return gz != NULL || out != NULL;
+}
+
+
+void DimacsWriter::open(FILE* f)
+{
+    close();
+    out = f;
+    own = false;
+    failed = false;
+}
+
+
+void DimacsWriter::flushBuffer()
+{
+    if (pos == 0) return;
+    if (gz != NULL)
+        failed |= gzwrite(gz, buf, pos) != pos;
+    else if (out != NULL)
+        failed |= fwrite(buf, 1, pos, out) != (size_t)pos;
+    pos = 0;
+}
+
+
+bool DimacsWriter::close()
+{
+    flushBuffer();
+    if (gz != NULL)
+        failed |= gzclose(gz) != Z_OK;
+    else if (out != NULL)
+        failed |= (own ? fclose(out) : fflush(out)) != 0;
+    gz = NULL;
+    out = NULL;
+    return !failed;
+}
@@ -0,0 +1,148 @@
+/***************************************************************************************[DimacsWriter.h]
+ Glucose -- Copyright (c) 2009-2014, Gilles Audemard, Laurent Simon
+                                CRIL - Univ. Artois, France
+                                LRI  - Univ. Paris Sud, France (2009-2013)
+                                Labri - Univ. Bordeaux, France
+
+ Syrup (Glucose Parallel) -- Copyright (c) 2013-2014, Gilles Audemard, Laurent Simon
+                                CRIL - Univ. Artois, France
+                                Labri - Univ. Bordeaux, France
+
+Glucose sources are based on MiniSat (see below MiniSat copyrights). Permissions and copyrights of
+Glucose (sources until 2013, Glucose 3.0, single core) are exactly the same as Minisat on which it 
+is based on. (see below).
+
+Glucose-Syrup sources are based on another copyright. Permissions and copyrights for the parallel
+version of Glucose-Syrup (the "Software") are granted, free of charge, to deal with the Software
+without restriction, including the rights to use, copy, modify, merge, publish, distribute,
+sublicence, and/or sell copies of the Software, and to permit persons to whom the Software is 
+furnished to do so, subject to the following conditions:
+
+- The above and below copyrights notices and this permission notice shall be included in all
+copies or substantial portions of the Software;
+- The parallel version of Glucose (all files modified since Glucose 3.0 releases, 2013) cannot
+be used in any competitive event (sat competitions/evaluations) without the express permission of 
+the authors (Gilles Audemard / Laurent Simon). This is also the case for any competitive event
+using Glucose Parallel as an embedded SAT engine (single core or not).
+
+
+--------------- Original Minisat Copyrights
+
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef Glucose_DimacsWriter_h
+#define Glucose_DimacsWriter_h
+
+#include <stdio.h>
+#include <zlib.h>
+
+#include "core/SolverTypes.h"
+
+namespace Glucose {
+
+//=================================================================================================
+// DimacsWriter -- buffered output of a formula, in DIMACS or in a compact binary form, to a file
+// that is compressed with gzip if its name ends with ".gz". Lines are encoded into a memory buffer
+// which is written to the file when full.
+//
+// The binary form is a sequence of records: a kind byte, then numbers in the variable-length
+// encoding of binary DRAT (7 bits per byte, least significant first, of 2*u+neg where literals are
+// given as var+1):
+//   'p' <number of variables> 0             (header)
+//   'a' <literals> 0                        (clause)
+//   'l' <literals> 0 <LBD>                  (learnt clause)
+//   'k' <literals> 0 <k>                    (at most k of the literals are true)
+//   'e' <literals> 0                        (clause of the reconstruction stack, pivot first)
+// In DIMACS, the at most constraints are written as '<literals> <= k' (see 'parse_DIMACS_main()'),
+// the learnts as clauses (without their LBD) and the reconstruction stack as 'c elim' comments.
+
+class DimacsWriter {
+    FILE*           out;
+    gzFile          gz;
+    bool            own;            // 'out' is closed by 'close()'
+    bool            binary;
+    bool            failed;         // A write failed
+    int             buffer_size;
+    char*           buf;
+    int             pos;
+
+    void flushBuffer();
+
+    void room() { if (pos + 32 > buffer_size) flushBuffer(); }
+
+    void num(uint64_t u, bool neg) {
+        room();
+        if (binary){
+            u = 2 * u + neg;
+            while (u > 127) { buf[pos++] = (char)(128 | (u & 127)); u >>= 7; }
+            buf[pos++] = (char)u;
+        }else{
+            char tmp[24]; int n = 0;
+            do { tmp[n++] = '0' + u % 10; u /= 10; } while (u > 0);
+            if (neg) buf[pos++] = '-';
+            while (n > 0) buf[pos++] = tmp[--n];
+        } }
+
+    void text(const char* s) { for (; *s; s++) { room(); buf[pos++] = *s; } }
+
+public:
+    DimacsWriter(bool binary, int buffer_size = 1 << 20);
+    ~DimacsWriter();                // Closes the file
+
+    bool open (const char* file);   // False if the file cannot be created
+    void open (FILE* f);            // Write to 'f', which is flushed but not closed at the end
+    bool close();                   // False if something could not be written
+
+    void header (int nvars, int nclauses, bool cnfplus) {
+        if (binary){ room(); buf[pos++] = 'p'; num(nvars, false); num(0, false); }
+        else { text(cnfplus ? "p cnf+ " : "p cnf "); num(nvars, false); buf[pos++] = ' '; num(nclauses, false); buf[pos++] = '\n'; } }
+
+    void comment(const char* s) {
+        if (binary) return;
+        text("c "); text(s); text("\n"); }
+
+    // A record is 'begin()', its literals then one of the 'end' methods:
+    void begin(char kind) {
+        room();
+        if (binary) buf[pos++] = kind;
+        else if (kind == 'e') text("c elim "); }
+
+    void lit(Lit p) {
+        num(var(p) + 1, sign(p));
+        if (!binary) buf[pos++] = ' '; }
+
+    void end() {
+        room();
+        if (binary) buf[pos++] = 0;
+        else { buf[pos++] = '0'; buf[pos++] = '\n'; } }
+
+    void endLearnt(int lbd) {
+        end();
+        if (binary) num(lbd, false); }
+
+    void endAtMost(int k) {
+        if (binary){ end(); num(k, false); }
+        else { text("<= "); num(k, false); buf[pos++] = '\n'; } }
+};
+
+//=================================================================================================
+}
+
+#endif
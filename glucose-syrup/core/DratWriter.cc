@@ -0,0 +1,163 @@
+/****************************************************************************************[DratWriter.cc]
+ Glucose -- Copyright (c) 2009-2014, Gilles Audemard, Laurent Simon
+                                CRIL - Univ. Artois, France
+                                LRI  - Univ. Paris Sud, France (2009-2013)
+                                Labri - Univ. Bordeaux, France
+
+ Syrup (Glucose Parallel) -- Copyright (c) 2013-2014, Gilles Audemard, Laurent Simon
+                                CRIL - Univ. Artois, France
+                                Labri - Univ. Bordeaux, France
+
+Glucose sources are based on MiniSat (see below MiniSat copyrights). Permissions and copyrights of
+Glucose (sources until 2013, Glucose 3.0, single core) are exactly the same as Minisat on which it 
+is based on. (see below).
+
+Glucose-Syrup sources are based on another copyright. Permissions and copyrights for the parallel
+version of Glucose-Syrup (the "Software") are granted, free of charge, to deal with the Software
+without restriction, including the rights to use, copy, modify, merge, publish, distribute,
+sublicence, and/or sell copies of the Software, and to permit persons to whom the Software is 
+furnished to do so, subject to the following conditions:
+
+- The above and below copyrights notices and this permission notice shall be included in all
+copies or substantial portions of the Software;
+- The parallel version of Glucose (all files modified since Glucose 3.0 releases, 2013) cannot
+be used in any competitive event (sat competitions/evaluations) without the express permission of 
+the authors (Gilles Audemard / Laurent Simon). This is also the case for any competitive event
+using Glucose Parallel as an embedded SAT engine (single core or not).
+
+
+--------------- Original Minisat Copyrights
+
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#include <stdlib.h>
+
+#include "mtl/XAlloc.h"
+#include "core/DratWriter.h"
+
+using namespace Glucose;
+
+//=================================================================================================
+// Constructor/Destructor:
+
+
+DratWriter::DratWriter(FILE* o, bool bin, bool lr, bool thr, int size) :
+    out(o)
+  , binary(bin)
+  , lrat(lr)
+  , threaded(thr)
+  , buffer_size(size)
+  , front(NULL)
+  , pos(0)
+  , deleting(false)
+  , back(NULL)
+  , back_size(0)
+  , back_full(false)
+  , stop(false)
+{
+    front = (char*)xrealloc(NULL, buffer_size);
+    if (threaded){
+        back = (char*)xrealloc(NULL, buffer_size);
+        pthread_mutex_init(&mutex, NULL);
+        pthread_cond_init(&cond_work, NULL);
+        pthread_cond_init(&cond_done, NULL);
+        if (pthread_create(&thread, NULL, writer, this) != 0)
+            threaded = false;   // Write from the solver thread instead
+    }
+}
+
+
+DratWriter::~DratWriter()
+{
+    flush();
+    if (threaded){
+        pthread_mutex_lock(&mutex);
+        stop = true;
+        pthread_cond_signal(&cond_work);
+        pthread_mutex_unlock(&mutex);
+        pthread_join(thread, NULL);
+        pthread_cond_destroy(&cond_work);
+        pthread_cond_destroy(&cond_done);
+        pthread_mutex_destroy(&mutex);
+    }
+    free(front);
+    free(back);
+}
+
+
+//=================================================================================================
+// Output:
+
+
+void DratWriter::handOver()
+{
+    if (pos == 0) return;
+    if (!threaded){
+        fwrite(front, 1, pos, out);
+        pos = 0;
+        return;
+    }
+
+    // Wait for the previous buffer to be written, then swap:
+    pthread_mutex_lock(&mutex);
+    while (back_full)
+        pthread_cond_wait(&cond_done, &mutex);
+    char* tmp = back; back = front; front = tmp;
+    back_size = pos;
+    back_full = true;
+    pthread_cond_signal(&cond_work);
+    pthread_mutex_unlock(&mutex);
+    pos = 0;
+}
+
+
+void DratWriter::flush()
+{
+    if (deleting) { deleting = false; end(); }
+    handOver();
+    if (threaded){
+        pthread_mutex_lock(&mutex);
+        while (back_full)
+            pthread_cond_wait(&cond_done, &mutex);
+        pthread_mutex_unlock(&mutex);
+    }
+    fflush(out);
+}
+
+
+void* DratWriter::writer(void* arg)
+{
+    DratWriter& w = *(DratWriter*)arg;
+    pthread_mutex_lock(&w.mutex);
+    for (;;){
+        while (!w.back_full && !w.stop)
+            pthread_cond_wait(&w.cond_work, &w.mutex);
+        if (!w.back_full) break;  // (stopped)
+
+        // The back buffer belongs to this thread until it is marked free:
+        pthread_mutex_unlock(&w.mutex);
+        fwrite(w.back, 1, w.back_size, w.out);
+        pthread_mutex_lock(&w.mutex);
+        w.back_full = false;
+        pthread_cond_signal(&w.cond_done);
+    }
+    pthread_mutex_unlock(&w.mutex);
+    return NULL;
+}
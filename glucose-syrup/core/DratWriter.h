@@ -0,0 +1,174 @@
+/*****************************************************************************************[DratWriter.h]
+ Glucose -- Copyright (c) 2009-2014, Gilles Audemard, Laurent Simon
+                                CRIL - Univ. Artois, France
+                                LRI  - Univ. Paris Sud, France (2009-2013)
+                                Labri - Univ. Bordeaux, France
+
+ Syrup (Glucose Parallel) -- Copyright (c) 2013-2014, Gilles Audemard, Laurent Simon
+                                CRIL - Univ. Artois, France
+                                Labri - Univ. Bordeaux, France
+
+Glucose sources are based on MiniSat (see below MiniSat copyrights). Permissions and copyrights of
+Glucose (sources until 2013, Glucose 3.0, single core) are exactly the same as Minisat on which it 
+is based on. (see below).
+
+Glucose-Syrup sources are based on another copyright. Permissions and copyrights for the parallel
+version of Glucose-Syrup (the "Software") are granted, free of charge, to deal with the Software
+without restriction, including the rights to use, copy, modify, merge, publish, distribute,
+sublicence, and/or sell copies of the Software, and to permit persons to whom the Software is 
+furnished to do so, subject to the following conditions:
+
+- The above and below copyrights notices and this permission notice shall be included in all
+copies or substantial portions of the Software;
+- The parallel version of Glucose (all files modified since Glucose 3.0 releases, 2013) cannot
+be used in any competitive event (sat competitions/evaluations) without the express permission of 
+the authors (Gilles Audemard / Laurent Simon). This is also the case for any competitive event
+using Glucose Parallel as an embedded SAT engine (single core or not).
+
+
+--------------- Original Minisat Copyrights
+
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef Glucose_DratWriter_h
+#define Glucose_DratWriter_h
+
+#include <stdio.h>
+#include <pthread.h>
+
+#include "core/SolverTypes.h"
+
+namespace Glucose {
+
+//=================================================================================================
+// DratWriter -- buffered output of a DRAT proof (clause additions and deletions), in text or binary
+// format. Lines are encoded into a large memory buffer. A full buffer is written to the file either
+// directly or, with 'threaded', by a background thread while the solver fills the other buffer.
+//
+// With 'lrat', the proof is written in LRAT format instead: every clause has an ID and every added
+// clause comes with its antecedents (the clauses that make it unit-propagate to a conflict, in that
+// order). Consecutive deletions are gathered on a single line.
+
+class DratWriter {
+    FILE*           out;
+    bool            binary;
+    bool            lrat;
+    bool            threaded;
+    int             buffer_size;
+
+    char*           front;          // The buffer being filled
+    int             pos;
+    bool            deleting;       // A line of LRAT deletions is open
+    char*           back;           // The buffer being written (threaded mode)
+    int             back_size;
+    bool            back_full;
+    bool            stop;
+    pthread_t       thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t  cond_work;      // A buffer has to be written (or the thread has to stop)
+    pthread_cond_t  cond_done;      // The back buffer is free again
+
+    void handOver   ();             // Write the front buffer (or hand it to the thread)
+    static void* writer(void* arg);
+
+    void begin(char kind) {
+        if (deleting) { deleting = false; end(); }
+        if (pos + 32 > buffer_size) handOver();
+        if (binary)      front[pos++] = kind;
+        else if (kind == 'd') { front[pos++] = 'd'; front[pos++] = ' '; } }
+
+    // A number, as '[-]u ' in text and as the variable-length encoding of 2*u+neg in binary:
+    void num(uint64_t u, bool neg) {
+        if (pos + 32 > buffer_size) handOver();
+        if (binary){
+            u = 2 * u + neg;
+            while (u > 127) { front[pos++] = (char)(128 | (u & 127)); u >>= 7; }
+            front[pos++] = (char)u;
+        }else{
+            char tmp[24]; int n = 0;
+            for (; u > 0; u /= 10) tmp[n++] = '0' + u % 10;
+            if (neg) front[pos++] = '-';
+            while (n > 0) front[pos++] = tmp[--n];
+            front[pos++] = ' ';
+        } }
+
+    void lit(Lit p) { num(var(p) + 1, sign(p)); }
+
+    void zero() {
+        if (pos + 32 > buffer_size) handOver();
+        if (binary) front[pos++] = 0;
+        else      { front[pos++] = '0'; front[pos++] = ' '; } }
+
+    void end() {
+        if (pos + 32 > buffer_size) handOver();
+        if (binary) front[pos++] = 0;
+        else      { front[pos++] = '0'; front[pos++] = '\n'; } }
+
+public:
+    DratWriter(FILE* out, bool binary, bool lrat, bool threaded, int buffer_size = 1 << 22);
+    ~DratWriter();                  // Flushes everything (the file is not closed)
+
+    // Add a clause to the proof ('except' is left out), or delete one:
+    template<class Lits>
+    void addClause(const Lits& ps, Lit except = lit_Undef) {
+        begin('a');
+        for (int i = 0; i < ps.size(); i++)
+            if (ps[i] != except) lit(ps[i]);
+        end(); }
+
+    template<class Lits>
+    void deleteClause(const Lits& ps) {
+        begin('d');
+        for (int i = 0; i < ps.size(); i++)
+            lit(ps[i]);
+        end(); }
+
+    void addEmptyClause() { begin('a'); end(); }
+
+    // LRAT: add clause 'id', which follows by unit propagation on the clauses 'hints', or delete the
+    // clause 'id' ('last' is the last ID given):
+    template<class Lits>
+    void addClause(uint64_t id, const Lits& ps, const vec<uint64_t>& hints) {
+        assert(lrat);
+        begin('a');
+        num(id, false);
+        for (int i = 0; i < ps.size(); i++)
+            lit(ps[i]);
+        zero();
+        for (int i = 0; i < hints.size(); i++)
+            num(hints[i], false);
+        end(); }
+
+    void deleteClause(uint64_t last, uint64_t id) {
+        assert(lrat);
+        if (!deleting){
+            if (pos + 32 > buffer_size) handOver();
+            if (binary) front[pos++] = 'd';
+            else      { num(last, false); front[pos++] = 'd'; front[pos++] = ' '; }
+            deleting = true; }
+        num(id, false); }
+
+    void flush();                   // Everything added so far is written to the file
+};
+
+//=================================================================================================
+}
+
+#endif
@@ -0,0 +1,90 @@
+/*********************************************************************************[ExternalPropagator.h]
+ Glucose -- Copyright (c) 2009-2014, Gilles Audemard, Laurent Simon
+                                CRIL - Univ. Artois, France
+                                LRI  - Univ. Paris Sud, France (2009-2013)
+                                Labri - Univ. Bordeaux, France
+
+ Syrup (Glucose Parallel) -- Copyright (c) 2013-2014, Gilles Audemard, Laurent Simon
+                                CRIL - Univ. Artois, France
+                                Labri - Univ. Bordeaux, France
+
+Glucose sources are based on MiniSat (see below MiniSat copyrights). Permissions and copyrights of
+Glucose (sources until 2013, Glucose 3.0, single core) are exactly the same as Minisat on which it 
+is based on. (see below).
+
+Glucose-Syrup sources are based on another copyright. Permissions and copyrights for the parallel
+version of Glucose-Syrup (the "Software") are granted, free of charge, to deal with the Software
+without restriction, including the rights to use, copy, modify, merge, publish, distribute,
+sublicence, and/or sell copies of the Software, and to permit persons to whom the Software is 
+furnished to do so, subject to the following conditions:
+
+- The above and below copyrights notices and this permission notice shall be included in all
+copies or substantial portions of the Software;
+- The parallel version of Glucose (all files modified since Glucose 3.0 releases, 2013) cannot
+be used in any competitive event (sat competitions/evaluations) without the express permission of 
+the authors (Gilles Audemard / Laurent Simon). This is also the case for any competitive event
+using Glucose Parallel as an embedded SAT engine (single core or not).
+
+
+--------------- Original Minisat Copyrights
+
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef Glucose_ExternalPropagator_h
+#define Glucose_ExternalPropagator_h
+
+#include "mtl/Vec.h"
+#include "core/SolverTypes.h"
+
+namespace Glucose {
+
+//=================================================================================================
+// External propagator: constraints known to the application, given to the solver on demand
+// instead of being encoded as clauses up front (see 'Solver::connectPropagator()').
+//
+// The solver calls it at each fixpoint of the unit propagation:
+//   * 'notifyAssignment()' for each new assignment of an observed variable (see
+//     'Solver::observe()'), with its decision level, and 'notifyBacktrack()' when these levels
+//     are undone;
+//   * 'addClause()' until it returns false: clauses of the problem, kept until the end;
+//   * 'propagate()' until it returns 'lit_Undef': literals implied by the current assignment.
+// The reason of a propagated literal is only asked for ('reason()') if the conflict analysis
+// needs it. When all the variables are assigned, 'checkModel()' can refuse the model: its
+// next call to 'addClause()' must then give a clause that the model falsifies.
+//
+// Clauses and reasons only contain observed variables: they are frozen for the simplification.
+
+class ExternalPropagator {
+public:
+    virtual ~ExternalPropagator() {}
+
+    virtual void notifyAssignment (Lit p, int level)                  {}
+    virtual void notifyBacktrack  (int level)                         {} // Assignments above 'level' are undone.
+
+    virtual bool addClause        (vec<Lit>& clause)                  { return false; }
+    virtual Lit  propagate        ()                                  { return lit_Undef; }
+    virtual void reason           (Lit p, vec<Lit>& clause)           {} // 'p' and at least one literal false before 'p'.
+    virtual bool checkModel       (const vec<lbool>& model)           { return true; } // 'model' is indexed by variables.
+};
+
+//=================================================================================================
+}
+
+#endif
@@ -0,0 +1,188 @@
+/*************************************************************************************[LocalSearch.cc]
+ Glucose -- Copyright (c) 2009-2014, Gilles Audemard, Laurent Simon
+                                CRIL - Univ. Artois, France
+                                LRI  - Univ. Paris Sud, France (2009-2013)
+                                Labri - Univ. Bordeaux, France
+
+ Syrup (Glucose Parallel) -- Copyright (c) 2013-2014, Gilles Audemard, Laurent Simon
+                                CRIL - Univ. Artois, France
+                                Labri - Univ. Bordeaux, France
+
+Glucose sources are based on MiniSat (see below MiniSat copyrights). Permissions and copyrights of
+Glucose (sources until 2013, Glucose 3.0, single core) are exactly the same as Minisat on which it 
+is based on. (see below).
+
+Glucose-Syrup sources are based on another copyright. Permissions and copyrights for the parallel
+version of Glucose-Syrup (the "Software") are granted, free of charge, to deal with the Software
+without restriction, including the rights to use, copy, modify, merge, publish, distribute,
+sublicence, and/or sell copies of the Software, and to permit persons to whom the Software is 
+furnished to do so, subject to the following conditions:
+
+- The above and below copyrights notices and this permission notice shall be included in all
+copies or substantial portions of the Software;
+- The parallel version of Glucose (all files modified since Glucose 3.0 releases, 2013) cannot
+be used in any competitive event (sat competitions/evaluations) without the express permission of 
+the authors (Gilles Audemard / Laurent Simon). This is also the case for any competitive event
+using Glucose Parallel as an embedded SAT engine (single core or not).
+
+
+--------------- Original Minisat Copyrights
+
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#include <math.h>
+
+#include "core/LocalSearch.h"
+
+using namespace Glucose;
+
+//=================================================================================================
+// Constructor and problem construction:
+
+// Break counts above this bound are all given the same (tiny) probability:
+static const int max_break = 64;
+
+LocalSearch::LocalSearch(double cb, uint64_t s) : seed(s ? s : 0x9e3779b97f4a7c15ULL), flips(0)
+{
+    prob.growTo(max_break + 1);
+    for (int b = 0; b <= max_break; b++)
+        prob[b] = pow(1.0 + b, -cb);          // (polynomial probSAT, eps = 1)
+    clause_start.push(0);
+}
+
+
+void LocalSearch::addVar(bool sign)
+{
+    value.push(!sign);
+    breaks.push(0);
+}
+
+
+void LocalSearch::addClause(const vec<Lit>& ps)
+{
+    assert(ps.size() > 0);
+    for (int i = 0; i < ps.size(); i++)
+        lits.push(ps[i]);
+    clause_start.push(lits.size());
+}
+
+
+void LocalSearch::buildOccurrences()
+{
+    int nclauses = clause_start.size() - 1;
+    occ_start.clear();
+    occ_start.growTo(2 * value.size() + 1, 0);
+    for (int i = 0; i < lits.size(); i++)
+        occ_start[toInt(lits[i]) + 1]++;
+    for (int i = 1; i < occ_start.size(); i++)
+        occ_start[i] += occ_start[i - 1];
+
+    vec<int> fill;
+    occ_start.copyTo(fill);
+    occs.growTo(lits.size());
+    for (int c = 0; c < nclauses; c++)
+        for (int i = clause_start[c]; i < clause_start[c + 1]; i++)
+            occs[fill[toInt(lits[i])]++] = c;
+
+    num_true .growTo(nclauses, 0);
+    true_xor .growTo(nclauses, 0);
+    unsat_pos.growTo(nclauses, -1);
+    for (int c = 0; c < nclauses; c++){
+        for (int i = clause_start[c]; i < clause_start[c + 1]; i++)
+            if (isTrue(lits[i])){
+                num_true[c]++;
+                true_xor[c] ^= var(lits[i]); }
+        if (num_true[c] == 0)
+            makeUnsat(c);
+        else if (num_true[c] == 1)
+            breaks[true_xor[c]]++;
+    }
+}
+
+
+//=================================================================================================
+// Search:
+
+
+void LocalSearch::flip(Var v)
+{
+    Lit now_false = mkLit(v, !value[v]);      // The literal of 'v' which is currently true
+    Lit now_true  = ~now_false;
+    value[v] ^= 1;
+
+    for (int i = occ_start[toInt(now_true)]; i < occ_start[toInt(now_true) + 1]; i++){
+        int c = occs[i];
+        true_xor[c] ^= v;
+        if (num_true[c]++ == 0){
+            makeSat(c);
+            breaks[v]++;
+        }else if (num_true[c] == 2)
+            breaks[true_xor[c] ^ v]--;
+    }
+
+    for (int i = occ_start[toInt(now_false)]; i < occ_start[toInt(now_false) + 1]; i++){
+        int c = occs[i];
+        true_xor[c] ^= v;
+        if (--num_true[c] == 0){
+            makeUnsat(c);
+            breaks[v]--;
+        }else if (num_true[c] == 1)
+            breaks[true_xor[c]]++;
+    }
+    flips++;
+}
+
+
+int LocalSearch::run(int64_t max_flips)
+{
+    buildOccurrences();
+
+    int best = unsat.size();
+    since_best.clear();
+    for (int64_t n = 0; n < max_flips && unsat.size() > 0; n++){
+        // Pick a falsified clause, then one of its variables with a probability decreasing with its break count:
+        int c = unsat[random(unsat.size())];
+        int b = clause_start[c], e = clause_start[c + 1];
+        double sum = 0;
+        tmp_prob.clear();
+        for (int i = b; i < e; i++){
+            int br = breaks[var(lits[i])];
+            tmp_prob.push(prob[br < max_break ? br : max_break]);
+            sum += tmp_prob.last(); }
+
+        double r = sum * (random(1 << 30) / (double)(1 << 30));
+        int    i = b;
+        for (; i < e - 1; i++){
+            r -= tmp_prob[i - b];
+            if (r < 0) break; }
+
+        Var v = var(lits[i]);
+        flip(v);
+        since_best.push(v);
+        if (unsat.size() < best){
+            best = unsat.size();
+            since_best.clear(); }
+    }
+
+    // Go back to the best assignment (the counters are not needed anymore):
+    for (int i = 0; i < since_best.size(); i++)
+        value[since_best[i]] ^= 1;
+    return best;
+}
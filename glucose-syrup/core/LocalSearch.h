@@ -0,0 +1,117 @@
+/**************************************************************************************[LocalSearch.h]
+ Glucose -- Copyright (c) 2009-2014, Gilles Audemard, Laurent Simon
+                                CRIL - Univ. Artois, France
+                                LRI  - Univ. Paris Sud, France (2009-2013)
+                                Labri - Univ. Bordeaux, France
+
+ Syrup (Glucose Parallel) -- Copyright (c) 2013-2014, Gilles Audemard, Laurent Simon
+                                CRIL - Univ. Artois, France
+                                Labri - Univ. Bordeaux, France
+
+Glucose sources are based on MiniSat (see below MiniSat copyrights). Permissions and copyrights of
+Glucose (sources until 2013, Glucose 3.0, single core) are exactly the same as Minisat on which it 
+is based on. (see below).
+
+Glucose-Syrup sources are based on another copyright. Permissions and copyrights for the parallel
+version of Glucose-Syrup (the "Software") are granted, free of charge, to deal with the Software
+without restriction, including the rights to use, copy, modify, merge, publish, distribute,
+sublicence, and/or sell copies of the Software, and to permit persons to whom the Software is 
+furnished to do so, subject to the following conditions:
+
+- The above and below copyrights notices and this permission notice shall be included in all
+copies or substantial portions of the Software;
+- The parallel version of Glucose (all files modified since Glucose 3.0 releases, 2013) cannot
+be used in any competitive event (sat competitions/evaluations) without the express permission of 
+the authors (Gilles Audemard / Laurent Simon). This is also the case for any competitive event
+using Glucose Parallel as an embedded SAT engine (single core or not).
+
+
+--------------- Original Minisat Copyrights
+
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef Glucose_LocalSearch_h
+#define Glucose_LocalSearch_h
+
+#include "mtl/Vec.h"
+#include "core/SolverTypes.h"
+
+namespace Glucose {
+
+//=================================================================================================
+// LocalSearch -- a probSAT local search over a copy of the (simplified) original clauses, used to
+// initialize the saved phases of the solver. Clauses and occurrence lists are stored in flat arrays.
+// For each clause, the number of true literals and the xor of their variables are kept, which gives
+// the only true variable of a clause in constant time, hence the break counts.
+
+class LocalSearch {
+    // Clauses: literals of clause 'c' are lits[clause_start[c] .. clause_start[c+1]):
+    vec<Lit>      lits;
+    vec<int>      clause_start;
+    // Occurrences: clauses containing 'p' are occs[occ_start[toInt(p)] .. occ_start[toInt(p)+1]):
+    vec<int>      occs;
+    vec<int>      occ_start;
+
+    vec<char>     value;            // value[v] is 1 if 'v' is true
+    vec<int>      num_true;         // Number of true literals of each clause
+    vec<Var>      true_xor;         // Xor of the variables of these literals
+    vec<int>      breaks;           // Number of clauses in which 'v' is the only true variable
+    vec<int>      unsat;            // The falsified clauses...
+    vec<int>      unsat_pos;        // ... and their position in 'unsat' (-1 if satisfied)
+    vec<Var>      since_best;       // Variables flipped since the best assignment
+    vec<double>   prob;             // prob[b]: (relative) probability to flip a variable of break count b
+    vec<double>   tmp_prob;
+
+    uint64_t      seed;
+
+    bool isTrue(Lit p) const { return value[var(p)] != sign(p); }
+    int  random(int n) {            // (xorshift)
+        seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17;
+        return (int)(seed % (uint64_t)n); }
+    void makeUnsat(int c) { unsat_pos[c] = unsat.size(); unsat.push(c); }
+    void makeSat(int c) {
+        int last = unsat.last();
+        unsat[unsat_pos[c]] = last;
+        unsat_pos[last] = unsat_pos[c];
+        unsat_pos[c] = -1;
+        unsat.pop(); }
+
+    void buildOccurrences();
+    void flip(Var v);
+
+public:
+    LocalSearch(double cb, uint64_t seed);
+
+    // Statistics:
+    uint64_t flips;
+
+    void addVar   (bool sign);      // The initial phase of a variable, as in 'Solver::polarity'
+    void addClause(const vec<Lit>& ps);
+
+    // Run at most 'max_flips' flips and go back to the best assignment found. Returns the number of
+    // clauses it falsifies:
+    int  run      (int64_t max_flips);
+    bool phase    (Var v) const { return !value[v]; }
+};
+
+//=================================================================================================
+}
+
+#endif
@@ -0,0 +1,127 @@
+/*************************************************************************************[PhaseTimers.h]
+ Glucose -- Copyright (c) 2009-2014, Gilles Audemard, Laurent Simon
+                                CRIL - Univ. Artois, France
+                                LRI  - Univ. Paris Sud, France (2009-2013)
+                                Labri - Univ. Bordeaux, France
+
+ Syrup (Glucose Parallel) -- Copyright (c) 2013-2014, Gilles Audemard, Laurent Simon
+                                CRIL - Univ. Artois, France
+                                Labri - Univ. Bordeaux, France
+
+Glucose sources are based on MiniSat (see below MiniSat copyrights). Permissions and copyrights of
+Glucose (sources until 2013, Glucose 3.0, single core) are exactly the same as Minisat on which it 
+is based on. (see below).
+
+Glucose-Syrup sources are based on another copyright. Permissions and copyrights for the parallel
+version of Glucose-Syrup (the "Software") are granted, free of charge, to deal with the Software
+without restriction, including the rights to use, copy, modify, merge, publish, distribute,
+sublicence, and/or sell copies of the Software, and to permit persons to whom the Software is 
+furnished to do so, subject to the following conditions:
+
+- The above and below copyrights notices and this permission notice shall be included in all
+copies or substantial portions of the Software;
+- The parallel version of Glucose (all files modified since Glucose 3.0 releases, 2013) cannot
+be used in any competitive event (sat competitions/evaluations) without the express permission of 
+the authors (Gilles Audemard / Laurent Simon). This is also the case for any competitive event
+using Glucose Parallel as an embedded SAT engine (single core or not).
+
+
+--------------- Original Minisat Copyrights
+
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef Glucose_PhaseTimers_h
+#define Glucose_PhaseTimers_h
+
+#include <stdio.h>
+#include <time.h>
+
+#include "mtl/IntTypes.h"
+#include "core/Constants.h"
+
+namespace Glucose {
+
+//=================================================================================================
+// Time spent in the main phases of the solver. The timers are compiled in only with PROFILE_PHASES
+// (see Constants.h): without it, TIME_PHASE() expands to nothing and all the times stay at 0.
+// Times are inclusive: the propagations done by simplify() count in both 'propagate' and
+// 'simplify', the garbage collections done by reduceDB() in both 'reduceDB' and 'garbageCollect'.
+
+enum Phase {
+    phase_propagate, phase_analyze, phase_reduceDB, phase_simplify, phase_garbageCollect, phase_eliminate,
+    phase_import, phase_export, nb_phases
+};
+
+class PhaseTimers {
+    uint64_t nsecs[nb_phases];
+    uint64_t calls[nb_phases];
+
+public:
+    PhaseTimers() { clear(); }
+
+    static const char* name(int phase) {
+        static const char* names[nb_phases] = {
+            "propagate", "analyze", "reduceDB", "simplify", "garbageCollect", "eliminate", "import", "export" };
+        return names[phase]; }
+
+    static uint64_t now() {          // (nanoseconds, a few tens of them per call through the vDSO)
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec; }
+
+    void     clear  ()                          { for (int i = 0; i < nb_phases; i++) nsecs[i] = calls[i] = 0; }
+    void     add    (int phase, uint64_t ns)    { nsecs[phase] += ns; calls[phase]++; }
+    void     add    (const PhaseTimers& t)      { for (int i = 0; i < nb_phases; i++) nsecs[i] += t.nsecs[i], calls[i] += t.calls[i]; }
+    double   seconds(int phase) const           { return nsecs[phase] / 1e9; }
+    uint64_t nbCalls(int phase) const           { return calls[phase]; }
+
+    void print() const {
+        for (int i = 0; i < nb_phases; i++)
+            if (calls[i] > 0)
+                printf("c time in %-14s: %-12.3f s (%" PRIu64" calls)\n", name(i), seconds(i), calls[i]); }
+
+    // One JSON object: {"propagate": {"seconds": 1.234, "calls": 5678}, ...}
+    void printJSON(FILE* out) const {
+        fprintf(out, "{");
+        for (int i = 0; i < nb_phases; i++)
+            fprintf(out, "%s\"%s\": {\"seconds\": %.6f, \"calls\": %" PRIu64"}", i ? ", " : "", name(i), seconds(i), calls[i]);
+        fprintf(out, "}"); }
+};
+
+// Adds the time spent in the enclosing scope to a phase:
+class PhaseTimer {
+    PhaseTimers& timers;
+    int          phase;
+    uint64_t     start;
+public:
+    PhaseTimer(PhaseTimers& t, int p) : timers(t), phase(p), start(PhaseTimers::now()) {}
+    ~PhaseTimer() { timers.add(phase, PhaseTimers::now() - start); }
+};
+
+#ifdef PROFILE_PHASES
+#define TIME_PHASE(timers, phase) PhaseTimer phase_timer_(timers, phase)
+#else
+#define TIME_PHASE(timers, phase)
+#endif
+
+//=================================================================================================
+}
+
+#endif
@@ -87,9 +87,30 @@ static DoubleOption opt_clause_decay(_cat, "cla-decay", "The clause activity dec
 static DoubleOption opt_random_var_freq(_cat, "rnd-freq", "The frequency with which the decision heuristic tries to choose a random variable", 0, DoubleRange(0, true, 1, true));
 static DoubleOption opt_random_seed(_cat, "rnd-seed", "Used by the random variable selection", 91648253, DoubleRange(0, false, HUGE_VAL, false));
 static IntOption opt_ccmin_mode(_cat, "ccmin-mode", "Controls conflict clause minimization (0=none, 1=basic, 2=deep)", 2, IntRange(0, 2));
+static IntOption opt_ccmin_budget(_cat, "ccmin-budget", "Literals visited to remove one literal, or shrink one level, of a learnt clause (0=no limit)", 1000, IntRange(0, INT32_MAX));
+static IntOption opt_shrink(_cat, "shrink", "Shrink the literals of each level of learnt clauses to one (0=none, 1=binary reasons, 2=all reasons, 3=all reasons and minimize)", 3, IntRange(0, 3));
 static IntOption opt_phase_saving(_cat, "phase-saving", "Controls the level of phase saving (0=none, 1=limited, 2=full)", 2, IntRange(0, 2));
 static BoolOption opt_rnd_init_act(_cat, "rnd-init", "Randomize the initial activity", false);
 static DoubleOption opt_garbage_frac(_cat, "gc-frac", "The fraction of wasted memory allowed before a garbage collection is triggered", 0.20, DoubleRange(0, false, HUGE_VAL, false));
+static BoolOption opt_gc_inplace(_cat, "gc-inplace", "Compact the clause database in place on garbage collection (no second region)", false);
+static BoolOption opt_gc_release(_cat, "gc-release", "Give memory freed by in place garbage collection back to the system", false);
+static DoubleOption opt_mem_budget(_cat, "mem-budget", "Resident memory in Mb the learnts are reduced to fit in, before giving up (0=none)", 0, DoubleRange(0, true, HUGE_VAL, false));
+static IntOption opt_huge_pages(_cat, "huge-pages", "Back the clause database with huge pages (0=no, 1=transparent, 2=explicit)", 0, IntRange(0, 2));
+static BoolOption opt_prefault(_cat, "prefault", "Fault in the clause database memory as soon as it grows", false);
+static BoolOption opt_ternary_watches(_cat, "ternary-watches", "Use dedicated watch lists for ternary clauses (propagation does not access them)", false);
+static IntOption opt_decision_queue(_cat, "vmtf", "Decision queue (0=VSIDS heap, 1=VMTF, 2=switch between them at restarts)", 0, IntRange(0, 2));
+static BoolOption opt_stable(_cr, "stable", "Alternate the LBD restarts with a stable mode (Luby or geometric restarts, target phases)", false);
+static IntOption opt_stable_restarts(_cr, "stable-restarts", "Restarts in stable mode (0=Luby, 1=geometric)", 0, IntRange(0, 1));
+static IntOption opt_stable_unit(_cr, "stable-unit", "Unit of the restart sequence of the stable mode (in conflicts)", 512, IntRange(1, INT32_MAX));
+static IntOption opt_stable_conflicts(_cr, "stable-conflicts", "Conflicts before the first switch to stable mode", 10000, IntRange(1, INT32_MAX));
+static IntOption opt_rephase_int(_cr, "rephase-int", "Conflicts between two rephases (with stable), growing arithmetically", 1000, IntRange(1, INT32_MAX));
+static BoolOption opt_local_search(_cat, "ls", "Initialize the saved phases with a local search (probSAT) on the original clauses", false);
+static IntOption opt_ls_flips(_cat, "ls-flips", "Budget of each local search (in flips)", 1000000, IntRange(1, INT32_MAX));
+static IntOption opt_ls_restarts(_cat, "ls-restarts", "Restarts between two local searches (0=only before the search and at the random rephases)", 0, IntRange(0, INT32_MAX));
+static DoubleOption opt_ls_cb(_cat, "ls-cb", "Break count base of the local search (flip probability (1+break)^-cb)", 2.38, DoubleRange(0, false, HUGE_VAL, false));
+static IntOption opt_queue_switch(_cat, "vmtf-switch", "Number of restarts between two switches of the decision queue (with vmtf=2)", 50, IntRange(1, INT32_MAX));
+static BoolOption opt_gauss(_cat, "gauss", "Find the XOR constraints during simplification, and propagate them by Gauss-Jordan elimination", false);
+static IntOption opt_gauss_max_vars(_cat, "gauss-max-vars", "No Gauss-Jordan elimination if the XOR constraints have more variables than this", 2000, IntRange(1, INT32_MAX));
 
 
 //=================================================================================================
@@ -117,15 +138,37 @@ verbosity(0)
 , random_var_freq(opt_random_var_freq)
 , random_seed(opt_random_seed)
 , ccmin_mode(opt_ccmin_mode)
+, ccmin_budget(opt_ccmin_budget)
+, shrink_mode(opt_shrink)
 , phase_saving(opt_phase_saving)
 , rnd_pol(false)
 , rnd_init_act(opt_rnd_init_act)
 , garbage_frac(opt_garbage_frac)
+, gc_inplace(opt_gc_inplace)
+, gc_release(opt_gc_release)
 , certifiedOutput(NULL)
 , certifiedUNSAT(false) // Not in the first parallel version 
+, certifiedBinary(false)
+, certifiedThread(false)
+, certifiedLRAT(false)
+, certifiedProof(NULL)
 , panicModeLastRemoved(0), panicModeLastRemovedShared(0)
 , useUnaryWatched(false)
 , promoteOneWatchedClause(true)
+, useTernaryWatches(opt_ternary_watches)
+, decisionQueue(opt_decision_queue)
+, queueSwitchRestarts(opt_queue_switch)
+, stableSearch(opt_stable)
+, stableRestarts(opt_stable_restarts)
+, stableUnit(opt_stable_unit)
+, stableConflicts(opt_stable_conflicts)
+, rephaseInterval(opt_rephase_int)
+, useLocalSearch(opt_local_search)
+, lsFlips(opt_ls_flips)
+, lsRestarts(opt_ls_restarts)
+, lsCb(opt_ls_cb)
+, useGauss(opt_gauss)
+, gaussMaxVars(opt_gauss_max_vars)
 // Statistics: (formerly in 'SolverStats')
 //
 , nbPromoted(0)
@@ -135,6 +178,10 @@ verbosity(0)
 , solves(0), starts(0), decisions(0), rnd_decisions(0), propagations(0), conflicts(0), conflictsRestarts(0)
 , nbstopsrestarts(0), nbstopsrestartssame(0), lastblockatrestart(0)
 , dec_vars(0), clauses_literals(0), learnts_literals(0), max_literals(0), tot_literals(0)
+, nbLocalSearches(0), lsFlipsTotal(0), lsLastUnsat(-1)
+, nbCardPropagations(0), nbCardExplanations(0)
+, nbGaussEliminations(0), nbXorPropagations(0), nbXorConflicts(0), nbXorExplanations(0)
+, nbExtPropagations(0), nbExtClauses(0), nbExtExplanations(0)
 , curRestart(1)
 
 , ok(true)
@@ -142,11 +189,19 @@ verbosity(0)
 , var_inc(1)
 , watches(WatcherDeleted(ca))
 , watchesBin(WatcherDeleted(ca))
+, watchesTer(TernaryWatcherDeleted(ca))
 , unaryWatches(WatcherDeleted(ca))
+, watchesCard(CardWatcherDeleted())
+, cardTrailHead(0)
+, xorWords(0)
+, xorTrailHead(-1)
+, propagator(NULL)
+, extTrailHead(0)
 , qhead(0)
 , simpDB_assigns(-1)
 , simpDB_props(0)
 , order_heap(VarOrderLt(activity))
+, useVMTF(opt_decision_queue == 1)
 , progress_estimate(0)
 , remove_satisfied(true)
 , reduceOnSize(false) // 
@@ -156,6 +211,8 @@ verbosity(0)
 //
 , conflict_budget(-1)
 , propagation_budget(-1)
+, deadline(0), deadline_countdown(0), deadline_interval(1), deadline_checked(0)
+, mem_budget(opt_mem_budget), mem_pressure(0), mem_next_check(0)
 , asynch_interrupt(false)
 , incremental(false)
 , nbVarsInitialFormula(INT32_MAX)
@@ -163,8 +220,26 @@ verbosity(0)
 , totalTime4Unsat(0.)
 , nbSatCalls(0)
 , nbUnsatCalls(0)
+, stableMode(false)
+, modeRestarts(0)
+, nextModeSwitch(opt_stable_conflicts)
+, modeConflicts(opt_stable_conflicts)
+, nextRephase(opt_rephase_int)
+, nbRephases(0)
+, targetAssigned(0)
+, bestAssigned(0)
 {
     MYFLAG = 0;
+#ifdef PACKED_VARDATA
+    assigns.records = &vardata;
+    seen.records = &vardata;
+#endif
+    lratLastId = 0;
+    lratUnitsDone = 0;
+    lratConflictId = 0;
+    // Process wide: applies to the next growth of the clause database (and of any other region)
+    xallocPolicy().huge_pages = opt_huge_pages;
+    xallocPolicy().prefault   = opt_prefault;
     // Initialize only first time. Useful for incremental solving (not in // version), useless otherwise
     // Kept here for simplicity
     lbdQueue.initSize(sizeLBDQueue);
@@ -196,15 +271,37 @@ Solver::Solver(const Solver &s) :
 , random_var_freq(s.random_var_freq)
 , random_seed(s.random_seed)
 , ccmin_mode(s.ccmin_mode)
+, ccmin_budget(s.ccmin_budget)
+, shrink_mode(s.shrink_mode)
 , phase_saving(s.phase_saving)
 , rnd_pol(s.rnd_pol)
 , rnd_init_act(s.rnd_init_act)
 , garbage_frac(s.garbage_frac)
+, gc_inplace(s.gc_inplace)
+, gc_release(s.gc_release)
 , certifiedOutput(NULL)
 , certifiedUNSAT(false) // Not in the first parallel version 
+, certifiedBinary(false)
+, certifiedThread(false)
+, certifiedLRAT(false)
+, certifiedProof(NULL)
 , panicModeLastRemoved(s.panicModeLastRemoved), panicModeLastRemovedShared(s.panicModeLastRemovedShared)
 , useUnaryWatched(s.useUnaryWatched)
 , promoteOneWatchedClause(s.promoteOneWatchedClause)
+, useTernaryWatches(s.useTernaryWatches)
+, decisionQueue(s.decisionQueue)
+, queueSwitchRestarts(s.queueSwitchRestarts)
+, stableSearch(s.stableSearch)
+, stableRestarts(s.stableRestarts)
+, stableUnit(s.stableUnit)
+, stableConflicts(s.stableConflicts)
+, rephaseInterval(s.rephaseInterval)
+, useLocalSearch(s.useLocalSearch)
+, lsFlips(s.lsFlips)
+, lsRestarts(s.lsRestarts)
+, lsCb(s.lsCb)
+, useGauss(s.useGauss)
+, gaussMaxVars(s.gaussMaxVars)
 // Statistics: (formerly in 'SolverStats')
 //
 , nbPromoted(s.nbPromoted)
@@ -218,6 +315,12 @@ Solver::Solver(const Solver &s) :
 , lastblockatrestart(s.lastblockatrestart)
 , dec_vars(s.dec_vars), clauses_literals(s.clauses_literals)
 , learnts_literals(s.learnts_literals), max_literals(s.max_literals), tot_literals(s.tot_literals)
+, nbLocalSearches(s.nbLocalSearches), lsFlipsTotal(s.lsFlipsTotal), lsLastUnsat(s.lsLastUnsat)
+, nbCardPropagations(s.nbCardPropagations), nbCardExplanations(s.nbCardExplanations)
+, nbGaussEliminations(s.nbGaussEliminations), nbXorPropagations(s.nbXorPropagations)
+, nbXorConflicts(s.nbXorConflicts), nbXorExplanations(s.nbXorExplanations)
+, nbExtPropagations(s.nbExtPropagations), nbExtClauses(s.nbExtClauses), nbExtExplanations(s.nbExtExplanations)
+, phaseTimers(s.phaseTimers)
 , curRestart(s.curRestart)
 
 , ok(true)
@@ -225,11 +328,19 @@ Solver::Solver(const Solver &s) :
 , var_inc(s.var_inc)
 , watches(WatcherDeleted(ca))
 , watchesBin(WatcherDeleted(ca))
+, watchesTer(TernaryWatcherDeleted(ca))
 , unaryWatches(WatcherDeleted(ca))
+, watchesCard(CardWatcherDeleted())
+, cardTrailHead(s.cardTrailHead)
+, xorWords(s.xorWords)
+, xorTrailHead(s.xorTrailHead)
+, propagator(NULL)
+, extTrailHead(0)
 , qhead(s.qhead)
 , simpDB_assigns(s.simpDB_assigns)
 , simpDB_props(s.simpDB_props)
 , order_heap(VarOrderLt(activity))
+, useVMTF(s.useVMTF)
 , progress_estimate(s.progress_estimate)
 , remove_satisfied(s.remove_satisfied)
 , reduceOnSize(s.reduceOnSize) // 
@@ -239,6 +350,8 @@ Solver::Solver(const Solver &s) :
 //
 , conflict_budget(s.conflict_budget)
 , propagation_budget(s.propagation_budget)
+, deadline(s.deadline), deadline_countdown(0), deadline_interval(s.deadline_interval), deadline_checked(s.deadline_checked)
+, mem_budget(s.mem_budget), mem_pressure(0), mem_next_check(0)
 , asynch_interrupt(s.asynch_interrupt)
 , incremental(s.incremental)
 , nbVarsInitialFormula(s.nbVarsInitialFormula)
@@ -246,13 +359,28 @@ Solver::Solver(const Solver &s) :
 , totalTime4Unsat(s.totalTime4Unsat)
 , nbSatCalls(s.nbSatCalls)
 , nbUnsatCalls(s.nbUnsatCalls)
+, stableMode(s.stableMode)
+, modeRestarts(s.modeRestarts)
+, nextModeSwitch(s.nextModeSwitch)
+, modeConflicts(s.modeConflicts)
+, nextRephase(s.nextRephase)
+, nbRephases(s.nbRephases)
+, targetAssigned(s.targetAssigned)
+, bestAssigned(s.bestAssigned)
 {
+#ifdef PACKED_VARDATA
+    assigns.records = &vardata;
+    seen.records = &vardata;
+#endif
     // Copy clauses.
     s.ca.copyTo(ca);
     ca.extra_clause_field = s.ca.extra_clause_field;
 
     // Initialize  other variables
      MYFLAG = 0;
+    lratLastId = 0;
+    lratUnitsDone = 0;
+    lratConflictId = 0;
     // Initialize only first time. Useful for incremental solving (not in // version), useless otherwise
     // Kept here for simplicity
     sumLBD = s.sumLBD;
@@ -261,16 +389,40 @@ Solver::Solver(const Solver &s) :
     // Copy all search vectors
     s.watches.copyTo(watches);
     s.watchesBin.copyTo(watchesBin);
+    s.watchesTer.copyTo(watchesTer);
     s.unaryWatches.copyTo(unaryWatches);
-    s.assigns.memCopyTo(assigns);
+    s.watchesCard.copyTo(watchesCard);
+    s.cards.memCopyTo(cards);
+    s.cardLits.memCopyTo(cardLits);
+    s.cardReason.memCopyTo(cardReason);
+    s.xorVars.memCopyTo(xorVars);
+    s.xorRhs.memCopyTo(xorRhs);
+    s.xorVarCol.memCopyTo(xorVarCol);
+    s.xorColVar.memCopyTo(xorColVar);
+    s.xorMatrix.memCopyTo(xorMatrix);
+    s.xorRows.memCopyTo(xorRows);
+    s.xorRowsRhs.memCopyTo(xorRowsRhs);
+    s.xorPivot.memCopyTo(xorPivot);
+    s.xorAssigned.memCopyTo(xorAssigned);
+    s.xorTrue.memCopyTo(xorTrue);
+    s.xorReason.memCopyTo(xorReason);
+    s.xorReason.memCopyTo(xorReason);
+    s.observed.memCopyTo(observed);
     s.vardata.memCopyTo(vardata);
     s.activity.memCopyTo(activity);
+#ifndef PACKED_VARDATA
+    s.assigns.memCopyTo(assigns);
     s.seen.memCopyTo(seen);
+#endif
     s.permDiff.memCopyTo(permDiff);
+    s.lratUnit.memCopyTo(lratUnit);
     s.polarity.memCopyTo(polarity);
+    s.targetPolarity.memCopyTo(targetPolarity);
+    s.bestPolarity.memCopyTo(bestPolarity);
     s.decision.memCopyTo(decision);
     s.trail.memCopyTo(trail);
     s.order_heap.copyTo(order_heap);
+    s.vmtf_queue.copyTo(vmtf_queue);
     s.clauses.memCopyTo(clauses);
     s.learnts.memCopyTo(learnts);
 
@@ -280,6 +432,28 @@ Solver::Solver(const Solver &s) :
 }
 
 Solver::~Solver() {
+    delete certifiedProof;
+}
+
+
+DratWriter& Solver::proof() {
+    if (certifiedProof == NULL)
+        certifiedProof = new DratWriter(certifiedOutput, certifiedBinary, certifiedLRAT, certifiedThread);
+    return *certifiedProof;
+}
+
+
+void Solver::closeProof(bool unsat) {
+    if (!certifiedUNSAT) return;
+    if (unsat && certifiedLRAT)
+        lratEmptyClause();
+    else if (unsat)
+        proof().addEmptyClause();
+    delete certifiedProof;
+    certifiedProof = NULL;
+    fclose(certifiedOutput);
+    certifiedOutput = NULL;
+    certifiedUNSAT = false;
 }
 
 /****************************************************************
@@ -317,16 +491,29 @@ Var Solver::newVar(bool sign, bool dvar) {
     watches .init(mkLit(v, true));
     watchesBin .init(mkLit(v, false));
     watchesBin .init(mkLit(v, true));
+    watchesTer .init(mkLit(v, false));
+    watchesTer .init(mkLit(v, true));
     unaryWatches .init(mkLit(v, false));
     unaryWatches .init(mkLit(v, true));
+    watchesCard .init(mkLit(v, false));
+    watchesCard .init(mkLit(v, true));
+#ifndef PACKED_VARDATA
     assigns .push(l_Undef);
+    seen .push(0);
+#endif
     vardata .push(mkVarData(CRef_Undef, 0));
+    cardReason .push(-1);
+    xorVarCol .push(-1);
+    observed .push(0);
     activity .push(rnd_init_act ? drand(random_seed) * 0.00001 : 0);
-    seen .push(0);
     permDiff .push(0);
+    lratUnit .push(0);
     polarity .push(sign);
+    targetPolarity.push(2);
+    bestPolarity.push(2);
     decision .push();
     trail .capacity(v + 1);
+    vmtf_queue.init(v);
     setDecisionVar(v, dvar);
     return v;
 }
@@ -334,6 +521,7 @@ Var Solver::newVar(bool sign, bool dvar) {
 bool Solver::addClause_(vec<Lit>& ps) {
 
     assert(decisionLevel() == 0);
+    if (certifiedLRAT) return addClauseLRAT_(ps);
     if (!ok) return false;
 
     // Check if clause is satisfied and remove false/duplicate literals:
@@ -360,14 +548,8 @@ bool Solver::addClause_(vec<Lit>& ps) {
     ps.shrink(i - j);
 
     if (flag && (certifiedUNSAT)) {
-        for (i = j = 0, p = lit_Undef; i < ps.size(); i++)
-            fprintf(certifiedOutput, "%i ", (var(ps[i]) + 1) * (-2 * sign(ps[i]) + 1));
-        fprintf(certifiedOutput, "0\n");
-
-        fprintf(certifiedOutput, "d ");
-        for (i = j = 0, p = lit_Undef; i < oc.size(); i++)
-            fprintf(certifiedOutput, "%i ", (var(oc[i]) + 1) * (-2 * sign(oc[i]) + 1));
-        fprintf(certifiedOutput, "0\n");
+        proof().addClause(ps);
+        proof().deleteClause(oc);
     }
 
 
@@ -385,6 +567,121 @@ bool Solver::addClause_(vec<Lit>& ps) {
     return true;
 }
 
+
+/*_________________________________________________________________________________________________
+|
+|  addAtMost_ : (ps : vec<Lit>&) (k : int)  ->  [bool]
+|  
+|  Description:
+|    Add the constraint: at most 'k' literals of 'ps' are true. The variables must be distinct,
+|    apart from pairs 'x', '~x' (exactly one of them is true). Returns false if the constraints are
+|    unsatisfiable.
+|
+|    The constraint is watched on all its literals, and seen when one of them becomes true. When
+|    'k' of them are true, the other ones are implied false with 'CRef_Card' as reason: the clause
+|    explaining the implication is only built if the conflict analysis reaches it (see 'explain()'),
+|    and it is then kept as a learnt clause. Not available with certified UNSAT: the proof could not
+|    justify the explanations.
+|________________________________________________________________________________________________@*/
+bool Solver::addAtMost_(vec<Lit>& ps, int k) {
+    assert(decisionLevel() == 0);
+    if (certifiedUNSAT) {
+        printf("Can not use cardinality constraints and certified unsat in the same time\n");
+        exit(1);
+    }
+    if (!ok) return false;
+
+    // Remove the pairs 'x', '~x' and the assigned literals:
+    sort(ps);
+    int i, j;
+    for (i = j = 0; i < ps.size(); i++) {
+        assert(i == 0 || ps[i] != ps[i - 1]);
+        if (i + 1 < ps.size() && ps[i + 1] == ~ps[i])
+            k--, i++;
+        else if (value(ps[i]) == l_True)
+            k--;
+        else if (value(ps[i]) == l_Undef)
+            ps[j++] = ps[i];
+    }
+    ps.shrink(i - j);
+
+    if (k < 0)
+        return ok = false;
+    else if (k >= ps.size())
+        return true;
+    else if (k == 0) {
+        for (i = 0; i < ps.size(); i++)
+            uncheckedEnqueue(~ps[i]);
+        return ok = (propagate() == CRef_Undef);
+    } else if (k == ps.size() - 1) {
+        // One of them is false: a clause
+        for (i = 0; i < ps.size(); i++)
+            ps[i] = ~ps[i];
+        return addClause_(ps);
+    }
+
+    CardConstraint c = { k, cardLits.size(), ps.size(), 0 };
+    for (i = 0; i < ps.size(); i++) {
+        cardLits.push(ps[i]);
+        watchesCard[ps[i]].push(cards.size());
+    }
+    cards.push(c);
+    return true;
+}
+
+
+// With LRAT proofs, the clause keeps the ID it has in the input: false literals are not removed
+// (they are moved at the end) and nothing is written to the proof.
+
+bool Solver::addClauseLRAT_(vec<Lit>& ps) {
+    uint64_t id = ++lratLastId; // (counted even when the clause is not kept)
+    if (!ok) return false;
+
+    if (!ca.clause_ids) {
+        assert(clauses.size() == 0 && learnts.size() == 0);
+        ca.clause_ids = true;
+    }
+
+    // Check if clause is satisfied and remove duplicate literals:
+    sort(ps);
+    Lit p;
+    int i, j;
+    for (i = j = 0, p = lit_Undef; i < ps.size(); i++)
+        if (value(ps[i]) == l_True || ps[i] == ~p)
+            return true;
+        else if (ps[i] != p)
+            ps[j++] = p = ps[i];
+    ps.shrink(i - j);
+
+    for (i = j = 0; i < ps.size(); i++)
+        if (value(ps[i]) != l_False) {
+            Lit q = ps[i]; ps[i] = ps[j]; ps[j++] = q;
+        }
+
+    if (j == 0) {
+        ps.copyTo(lratConflict);
+        lratConflictId = id;
+        return ok = false;
+    } else if (ps.size() == 1) {
+        lratUnit[var(ps[0])] = id;
+        uncheckedEnqueue(ps[0]);
+    } else {
+        CRef cr = ca.alloc(ps, false);
+        ca.setId(ca[cr], id);
+        clauses.push(cr);
+        attachClause(cr);
+        if (j > 1) return true;
+        uncheckedEnqueue(ps[0], cr);
+    }
+
+    CRef confl = propagate();
+    if (confl != CRef_Undef) {
+        lratRootConflict(confl);
+        return ok = false;
+    }
+    return true;
+}
+
 void Solver::attachClause(CRef cr) {
     const Clause& c = ca[cr];
 
@@ -392,6 +689,10 @@ void Solver::attachClause(CRef cr) {
     if (c.size() == 2) {
         watchesBin[~c[0]].push(Watcher(cr, c[1]));
         watchesBin[~c[1]].push(Watcher(cr, c[0]));
+    } else if (isTernaryWatched(c)) {
+        watchesTer[~c[0]].push(TernaryWatcher(cr, c[1], c[2]));
+        watchesTer[~c[1]].push(TernaryWatcher(cr, c[0], c[2]));
+        watchesTer[~c[2]].push(TernaryWatcher(cr, c[0], c[1]));
     } else {
         watches[~c[0]].push(Watcher(cr, c[1]));
         watches[~c[1]].push(Watcher(cr, c[0]));
@@ -421,6 +722,16 @@ void Solver::detachClause(CRef cr, bool strict) {
             watchesBin.smudge(~c[0]);
             watchesBin.smudge(~c[1]);
         }
+    } else if (isTernaryWatched(c)) {
+        if (strict) {
+            remove(watchesTer[~c[0]], TernaryWatcher(cr, c[1], c[2]));
+            remove(watchesTer[~c[1]], TernaryWatcher(cr, c[0], c[2]));
+            remove(watchesTer[~c[2]], TernaryWatcher(cr, c[0], c[1]));
+        } else {
+            watchesTer.smudge(~c[0]);
+            watchesTer.smudge(~c[1]);
+            watchesTer.smudge(~c[2]);
+        }
     } else {
         if (strict) {
             remove(watches[~c[0]], Watcher(cr, c[1]));
@@ -452,19 +763,18 @@ void Solver::removeClause(CRef cr, bool inPurgatory) {
 
     Clause& c = ca[cr];
 
-    if (certifiedUNSAT) {
-        fprintf(certifiedOutput, "d ");
-        for (int i = 0; i < c.size(); i++)
-            fprintf(certifiedOutput, "%i ", (var(c[i]) + 1) * (-2 * sign(c[i]) + 1));
-        fprintf(certifiedOutput, "0\n");
-    }
+    if (certifiedLRAT)
+        proof().deleteClause(lratLastId, ca.id(c));
+    else if (certifiedUNSAT)
+        proof().deleteClause(c);
 
     if (inPurgatory)
         detachClausePurgatory(cr);
     else
         detachClause(cr);
     // Don't leave pointers to free'd memory!
-    if (locked(c)) vardata[var(c[0])].reason = CRef_Undef;
+    int k = lockedLit(c);
+    if (k >= 0) vardata[var(c[k])].reason = CRef_Undef;
     c.mark(1);
     ca.free(cr);
 }
@@ -484,16 +794,17 @@ bool Solver::satisfied(const Clause& c) const {
  * Compute LBD functions
  *************************************************************/
 
-inline unsigned int Solver::computeLBD(const vec<Lit> & lits,int end) {
+template<bool Incremental>
+inline unsigned int Solver::computeLBD_(const vec<Lit> & lits,int end) {
   int nblevels = 0;
   MYFLAG++;
 
-  if(incremental) { // ----------------- INCREMENTAL MODE
+  if(Incremental) { // ----------------- INCREMENTAL MODE
     if(end==-1) end = lits.size();
     int nbDone = 0;
     for(int i=0;i<lits.size();i++) {
       if(nbDone>=end) break;
-      if(isSelector(var(lits[i]))) continue;
+      if(isSelector_<Incremental>(var(lits[i]))) continue;
       nbDone++;
       int l = level(var(lits[i]));
       if (permDiff[l] != MYFLAG) {
@@ -517,15 +828,16 @@ inline unsigned int Solver::computeLBD(const vec<Lit> & lits,int end) {
     return lits.size() + nblevels;
 }
 
-inline unsigned int Solver::computeLBD(const Clause &c) {
+template<bool Incremental>
+inline unsigned int Solver::computeLBD_(const Clause &c) {
   int nblevels = 0;
   MYFLAG++;
 
-  if(incremental) { // ----------------- INCREMENTAL MODE
+  if(Incremental) { // ----------------- INCREMENTAL MODE
      unsigned int nbDone = 0;
     for(int i=0;i<c.size();i++) {
       if(nbDone>=c.sizeWithoutSelectors()) break;
-      if(isSelector(var(c[i]))) continue;
+      if(isSelector_<Incremental>(var(c[i]))) continue;
       nbDone++;
       int l = level(var(c[i]));
       if (permDiff[l] != MYFLAG) {
@@ -550,6 +862,14 @@ inline unsigned int Solver::computeLBD(const Clause &c) {
 
 }
 
+inline unsigned int Solver::computeLBD(const vec<Lit> & lits,int end) {
+  return incremental ? computeLBD_<true>(lits, end) : computeLBD_<false>(lits, end);
+}
+
+inline unsigned int Solver::computeLBD(const Clause &c) {
+  return incremental ? computeLBD_<true>(c) : computeLBD_<false>(c);
+}
+
 /******************************************************************
  * Minimisation with binary reolution
  ******************************************************************/
@@ -573,6 +893,8 @@ void Solver::minimisationWithBinaryResolution(vec<Lit> &out_learnt) {
             if (permDiff[var(imp)] == MYFLAG && value(imp) == l_True) {
                 nb++;
                 permDiff[var(imp)] = MYFLAG - 1;
+                if (certifiedLRAT)
+                    lratMinimized.push(wbin[k].cref);
             }
         }
         int l = out_learnt.size() - 1;
@@ -599,6 +921,11 @@ void Solver::minimisationWithBinaryResolution(vec<Lit> &out_learnt) {
 
 void Solver::cancelUntil(int level) {
     if (decisionLevel() > level) {
+        for (; cardTrailHead > trail_lim[level]; cardTrailHead--) {
+            const vec<int>& ws = watchesCard[trail[cardTrailHead - 1]];
+            for (int i = 0; i < ws.size(); i++)
+                cards[ws[i]].ntrue--;
+        }
         for (int c = trail.size() - 1; c >= trail_lim[level]; c--) {
             Var x = var(trail[c]);
             assigns [x] = l_Undef;
@@ -610,6 +937,9 @@ void Solver::cancelUntil(int level) {
         qhead = trail_lim[level];
         trail.shrink(trail.size() - trail_lim[level]);
         trail_lim.shrink(trail_lim.size() - level);
+        if (xorTrailHead > trail.size()) xorTrailHead = trail.size();
+        if (extTrailHead > trail.size()) extTrailHead = trail.size();
+        if (propagator != NULL) propagator->notifyBacktrack(level);
     }
 }
 
@@ -620,6 +950,12 @@ void Solver::cancelUntil(int level) {
 Lit Solver::pickBranchLit() {
     Var next = var_Undef;
 
+    if (useVMTF) {
+        // Most recently bumped variable:
+        next = vmtf_queue.next(assigns, decision);
+        return next == var_Undef ? lit_Undef : mkLit(next, rnd_pol ? drand(random_seed) < 0.5 : decisionPolarity(next));
+    }
+
     // Random decision:
     if (drand(random_seed) < random_var_freq && !order_heap.empty()) {
         next = order_heap[irand(random_seed, order_heap.size())];
@@ -636,9 +972,10 @@ Lit Solver::pickBranchLit() {
             next = order_heap.removeMin();
         }
 
-    return next == var_Undef ? lit_Undef : mkLit(next, rnd_pol ? drand(random_seed) < 0.5 : polarity[next]);
+    return next == var_Undef ? lit_Undef : mkLit(next, rnd_pol ? drand(random_seed) < 0.5 : decisionPolarity(next));
 }
 
+
 /*_________________________________________________________________________________________________
 |
 |  analyze : (confl : Clause*) (out_learnt : vec<Lit>&) (out_btlevel : int&)  ->  [void]
@@ -657,8 +994,18 @@ Lit Solver::pickBranchLit() {
 |  
 |________________________________________________________________________________________________@*/
 void Solver::analyze(CRef confl, vec<Lit>& out_learnt,vec<Lit>&selectors, int& out_btlevel,unsigned int &lbd,unsigned int &szWithoutSelectors) {
+    if (incremental)
+        analyze_<true>(confl, out_learnt, selectors, out_btlevel, lbd, szWithoutSelectors);
+    else
+        analyze_<false>(confl, out_learnt, selectors, out_btlevel, lbd, szWithoutSelectors);
+}
+
+template<bool Incremental>
+void Solver::analyze_(CRef confl, vec<Lit>& out_learnt,vec<Lit>&selectors, int& out_btlevel,unsigned int &lbd,unsigned int &szWithoutSelectors) {
+    TIME_PHASE(phaseTimers, phase_analyze);
     int pathC = 0;
     Lit p = lit_Undef;
+    CRef conflicting = confl;
 
 
     // Generate conflict clause:
@@ -667,15 +1014,12 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt,vec<Lit>&selectors, int& o
     int index = trail.size() - 1;
     do {
         assert(confl != CRef_Undef); // (otherwise should be UIP)
+        if (lazyReason(confl)) confl = explain(var(p));
         Clause& c = ca[confl];
-        // Special case for binary clauses
+        // Special case for binary and ternary clauses
         // The first one has to be SAT
-        if (p != lit_Undef && c.size() == 2 && value(c[0]) == l_False) {
-
-            assert(value(c[1]) == l_True);
-            Lit tmp = c[0];
-            c[0] = c[1], c[1] = tmp;
-        }
+        if (p != lit_Undef)
+            reasonFirst(c, var(p));
 
         if (c.learnt()) {
             parallelImportClauseDuringConflictAnalysis(c,confl);
@@ -688,14 +1032,14 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt,vec<Lit>&selectors, int& o
         }
 
         // DYNAMIC NBLEVEL trick (see competition'09 companion paper)
-        if (c.learnt() && c.lbd() > 2) {
-            unsigned int nblevels = computeLBD(c);
-            if (nblevels + 1 < c.lbd()) { // improve the LBD
-                if (c.lbd() <= lbLBDFrozenClause) {
-                    c.setCanBeDel(false);
+        if (c.learnt() && ca.lbd(c) > 2) {
+            unsigned int nblevels = computeLBD_<Incremental>(c);
+            if (nblevels + 1 < ca.lbd(c)) { // improve the LBD
+                if (ca.lbd(c) <= lbLBDFrozenClause) {
+                    ca.setCanBeDel(c, false);
                 }
                 // seems to be interesting : keep it for the next round
-                c.setLBD(nblevels); // Update it
+                ca.setLBD(c, nblevels); // Update it
             }
         }
 
@@ -706,16 +1050,16 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt,vec<Lit>&selectors, int& o
             if (!seen[var(q)]) {
                 if (level(var(q)) == 0) {
                 } else { // Here, the old case 
-                    if(!isSelector(var(q)))
+                    if(!isSelector_<Incremental>(var(q)))
                         varBumpActivity(var(q));
                     seen[var(q)] = 1;
                     if (level(var(q)) >= decisionLevel()) {
                         pathC++;
                         // UPDATEVARACTIVITY trick (see competition'09 companion paper)
-                        if (!isSelector(var(q)) &&  (reason(var(q)) != CRef_Undef) && ca[reason(var(q))].learnt())
+                        if (!isSelector_<Incremental>(var(q)) &&  (reason(var(q)) != CRef_Undef) && !lazyReason(reason(var(q))) && ca[reason(var(q))].learnt())
                             lastDecisionLevel.push(q);
                     } else {
-                        if(isSelector(var(q))) {
+                        if(isSelector_<Incremental>(var(q))) {
                             assert(value(q) == l_False);
                             selectors.push(q);
                         } else 
@@ -743,11 +1087,11 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt,vec<Lit>&selectors, int& o
         out_learnt.push(selectors[i]);
 
     out_learnt.copyTo(analyze_toclear);
-    if (ccmin_mode == 2) {
-        uint32_t abstract_level = 0;
-        for (i = 1; i < out_learnt.size(); i++)
-            abstract_level |= abstractLevel(var(out_learnt[i])); // (maintain an abstraction of levels involved in conflict)
+    uint32_t abstract_level = 0;
+    for (i = 1; i < out_learnt.size(); i++)
+        abstract_level |= abstractLevel(var(out_learnt[i])); // (maintain an abstraction of levels involved in conflict)
 
+    if (ccmin_mode == 2) {
         for (i = j = 1; i < out_learnt.size(); i++)
             if (reason(var(out_learnt[i])) == CRef_Undef || !litRedundant(out_learnt[i], abstract_level))
                 out_learnt[j++] = out_learnt[i];
@@ -759,9 +1103,9 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt,vec<Lit>&selectors, int& o
             if (reason(x) == CRef_Undef)
                 out_learnt[j++] = out_learnt[i];
             else {
-                Clause& c = ca[reason(var(out_learnt[i]))];
+                Clause& c = ca[explain(var(out_learnt[i]))];
                 // Thanks to Siert Wieringa for this bug fix!
-                for (int k = ((c.size() == 2) ? 0 : 1); k < c.size(); k++)
+                for (int k = ((c.size() <= 3) ? 0 : 1); k < c.size(); k++)
                     if (!seen[var(c[k])] && level(var(c[k])) > 0) {
                         out_learnt[j++] = out_learnt[i];
                         break;
@@ -773,6 +1117,8 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt,vec<Lit>&selectors, int& o
 
     max_literals += out_learnt.size();
     out_learnt.shrink(i - j);
+    if (!Incremental && shrink_mode > 0)
+        shrinkLearnt(out_learnt, abstract_level);
     tot_literals += out_learnt.size();
 
 
@@ -782,7 +1128,7 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt,vec<Lit>&selectors, int& o
       Then, we reduce clauses with small LBD.
       Otherwise, this can be useless
      */
-    if (!incremental && out_learnt.size() <= lbSizeMinimizingClause) {
+    if (!Incremental && out_learnt.size() <= lbSizeMinimizingClause) {
         minimisationWithBinaryResolution(out_learnt);
     }
     // Find correct backtrack level:
@@ -801,71 +1147,307 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt,vec<Lit>&selectors, int& o
         out_learnt[1] = p;
         out_btlevel = level(var(p));
     }
-   if(incremental) {
+   if(Incremental) {
       szWithoutSelectors = 0;
       for(int i=0;i<out_learnt.size();i++) {
-	if(!isSelector(var((out_learnt[i])))) szWithoutSelectors++; 
+	if(!isSelector_<Incremental>(var((out_learnt[i])))) szWithoutSelectors++; 
 	else if(i>0) break;
       }
     } else 
       szWithoutSelectors = out_learnt.size();
     
     // Compute LBD
-    lbd = computeLBD(out_learnt,out_learnt.size()-selectors.size());
+    lbd = computeLBD_<Incremental>(out_learnt,out_learnt.size()-selectors.size());
      
     // UPDATEVARACTIVITY trick (see competition'09 companion paper)
     if (lastDecisionLevel.size() > 0) {
         for (int i = 0; i < lastDecisionLevel.size(); i++) {
-            if (ca[reason(var(lastDecisionLevel[i]))].lbd() < lbd)
+            if (ca.lbd(ca[reason(var(lastDecisionLevel[i]))]) < lbd)
                 varBumpActivity(var(lastDecisionLevel[i]));
         }
         lastDecisionLevel.clear();
     }
+    if (useVMTF)
+        vmtf_queue.update(assigns);
 
 
 
     for (int j = 0; j < analyze_toclear.size(); j++) seen[var(analyze_toclear[j])] = 0; // ('seen[]' is now cleared)
     for (int j = 0; j < selectors.size(); j++) seen[var(selectors[j])] = 0;
+
+    if (certifiedLRAT)
+        lratAntecedents(conflicting, out_learnt);
 }
 
 
 // Check if 'p' can be removed. 'abstract_levels' is used to abort early if the algorithm is
-// visiting literals at levels that cannot be removed later.
+// visiting literals at levels that cannot be removed later. The reasons are searched depth first,
+// and the literals met are marked removable or failed for the next calls on the same clause. 'p'
+// is kept when more than 'ccmin_budget' literals are searched.
 
 bool Solver::litRedundant(Lit p, uint32_t abstract_levels) {
+    assert(seen[var(p)] == seen_undef || seen[var(p)] == seen_source);
+    assert(reason(var(p)) != CRef_Undef);
+    vec<ShrinkStackElem>& stack = minimize_stack;
+    stack.clear();
+    int budget = ccmin_budget;
+    CRef cr = explain(var(p));
+    reasonFirst(ca[cr], var(p));
+
+    for (uint32_t i = 1; ; i++) {
+        if (i < (uint32_t)ca[cr].size()) {
+            // Checking 'p'-parents 'l':
+            Lit l = ca[cr][i];
+            Var x = var(l);
+            // Variable at level 0 or previously removable:
+            if (level(x) == 0 || seen[x] == seen_source || seen[x] == seen_removable)
+                continue;
+            // Check variable can not be removed for some local reason:
+            if (reason(x) == CRef_Undef || seen[x] == seen_failed || (abstractLevel(x) & abstract_levels) == 0
+                || (ccmin_budget > 0 && --budget < 0)) {
+                stack.push(ShrinkStackElem(0, p));
+                for (int k = 0; k < stack.size(); k++)
+                    if (seen[var(stack[k].l)] == seen_undef) {
+                        seen[var(stack[k].l)] = seen_failed;
+                        analyze_toclear.push(stack[k].l);
+                    }
+                return false;
+            }
+            // Recursively check 'l':
+            stack.push(ShrinkStackElem(i, p));
+            i = 0;
+            p = l;
+            cr = explain(x);
+            reasonFirst(ca[cr], x);
+        } else {
+            // Finished with current element 'p' and reason 'cr':
+            if (seen[var(p)] == seen_undef) {
+                seen[var(p)] = seen_removable;
+                analyze_toclear.push(p);
+            }
+            // Terminate with success if stack is empty:
+            if (stack.size() == 0) break;
+            // Continue with top element on stack:
+            i = stack.last().i;
+            p = stack.last().l;
+            cr = reason(var(p));
+            stack.pop();
+        }
+    }
+
+    return true;
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  shrinkLearnt : (out_learnt : vec<Lit>&) (abstract_levels : uint32_t)  ->  [void]
+|  
+|  Description:
+|    Replace the literals of each level of the (minimized) learnt clause by a single one: the first
+|    UIP of these literals on their level, when the reasons between them only bring literals of the
+|    same level or literals implied by the clause (see "Efficient All-UIP Learned Clause
+|    Minimization", Fleury and Biere, SAT'21). The LBD is unchanged, the clause is shorter.
+|    With 'shrink_mode' 1, only binary reasons are resolved, and with 3, the literals of lower
+|    levels brought by the reasons may also be removed by 'litRedundant()'.
+|
+|    The levels are shrunk from the highest: the reasons of a level only bring literals of lower
+|    levels, which still are in the clause or implied by it.
+|________________________________________________________________________________________________@*/
+void Solver::shrinkLearnt(vec<Lit>& out_learnt, uint32_t abstract_levels) {
+    if (out_learnt.size() <= 2) return;
+    sort((Lit*)out_learnt + 1, out_learnt.size() - 1, LevelGt(vardata));
+
+    int i, j, k;
+    for (i = j = 1; i < out_learnt.size(); i = k) {
+        int lvl = level(var(out_learnt[i]));
+        for (k = i + 1; k < out_learnt.size() && level(var(out_learnt[k])) == lvl; k++);
+        Lit uip = k - i > 1 ? shrinkLevel(out_learnt, i, k, abstract_levels) : lit_Undef;
+        if (uip != lit_Undef)
+            out_learnt[j++] = ~uip;
+        else
+            while (i < k) out_learnt[j++] = out_learnt[i++];
+    }
+    out_learnt.shrink(out_learnt.size() - j);
+}
+
+
+// The first UIP of the literals 'out_learnt[begin..end)' of one level, found by walking the trail
+// of the level backward, or lit_Undef if it cannot replace them (or past 'ccmin_budget' literals
+// of the trail). The marks are updated: the UIP is in the clause, the other literals met are
+// implied by it.
+
+Lit Solver::shrinkLevel(const vec<Lit>& out_learnt, int begin, int end, uint32_t abstract_levels) {
+    int lvl = level(var(out_learnt[begin]));
+    int open = end - begin;
+    int budget = ccmin_budget;
+    for (int i = begin; i < end; i++)
+        seen[var(out_learnt[i])] = seen_shrink;
+    shrink_pulled.clear();
+
+    Lit uip = lit_Undef;
+    for (int t = (lvl < decisionLevel() ? trail_lim[lvl] : trail.size()) - 1; ; t--) {
+        if (ccmin_budget > 0 && --budget < 0) break;
+        Var x = var(trail[t]);
+        if (seen[x] != seen_shrink) continue;
+        if (--open == 0) {
+            uip = trail[t];
+            break;
+        }
+        CRef cr = reason(x);
+        assert(cr != CRef_Undef); // (the decision is the last literal of the level on the walk)
+        if (shrink_mode == 1 && (lazyReason(cr) || ca[cr].size() != 2)) break;
+        cr = explain(x);
+        reasonFirst(ca[cr], x);
+
+        int k;
+        for (k = 1; k < ca[cr].size(); k++) {
+            Lit q = ca[cr][k];
+            Var y = var(q);
+            assert(level(y) <= lvl);
+            if (level(y) == 0 || seen[y] == seen_shrink) continue;
+            if (level(y) == lvl) {
+                if (seen[y] == seen_undef) analyze_toclear.push(q);
+                seen[y] = seen_shrink;
+                shrink_pulled.push(q);
+                open++;
+            } else if (seen[y] != seen_source && seen[y] != seen_removable
+                       && (shrink_mode < 3 || seen[y] == seen_failed || reason(y) == CRef_Undef || !litRedundant(q, abstract_levels)))
+                break;
+        }
+        if (k < ca[cr].size()) break;
+    }
+
+    if (uip != lit_Undef) {
+        for (int i = begin; i < end; i++) seen[var(out_learnt[i])] = seen_removable;
+        for (int i = 0; i < shrink_pulled.size(); i++) seen[var(shrink_pulled[i])] = seen_removable;
+        seen[var(uip)] = seen_source;
+    } else {
+        for (int i = begin; i < end; i++) seen[var(out_learnt[i])] = seen_source;
+        for (int i = 0; i < shrink_pulled.size(); i++) seen[var(shrink_pulled[i])] = seen_undef;
+    }
+    return uip;
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  lratAntecedents : (confl : CRef) (out_learnt : vec<Lit>&)  ->  [void]
+|  
+|  Description:
+|    Fill 'lratChain' with the antecedents of the learnt clause, in an order in which each of them
+|    becomes unit (and the last one, the conflicting clause, false) once the literals of the clause
+|    are falsified. The implication graph is searched depth first from the conflict, stopping at
+|    the literals of the learnt clause; a reason is output after the reasons of its own literals.
+|    This covers the resolution steps of 'analyze()' and the literals removed by the minimisation.
+|    Literals of level 0 are taken from their unit clauses, and the binary clauses used by
+|    'minimisationWithBinaryResolution()' come first (they only depend on the asserting literal).
+|  
+|    'seen[]' is 2 while a variable waits on the stack, 3 while its reason is searched, and 1 once
+|    it is done (or belongs to the learnt clause).
+|________________________________________________________________________________________________@*/
+void Solver::lratAntecedents(CRef confl, const vec<Lit>& out_learnt) {
+    lratDeriveUnits();
+    lratChain.clear();
+    analyze_toclear.clear();
+    for (int i = 0; i < out_learnt.size(); i++) {
+        seen[var(out_learnt[i])] = 1;
+        analyze_toclear.push(out_learnt[i]);
+    }
+    for (int i = 0; i < lratMinimized.size(); i++) {
+        const Clause& c = ca[lratMinimized[i]];
+        Lit imp = c[0] == out_learnt[0] ? c[1] : c[0];
+        seen[var(imp)] = 1;
+        analyze_toclear.push(imp);
+        lratChain.push(ca.id(c));
+    }
+    lratMinimized.clear();
+
     analyze_stack.clear();
-    analyze_stack.push(p);
-    int top = analyze_toclear.size();
+    const Clause& c = ca[confl];
+    for (int i = 0; i < c.size(); i++)
+        lratVisit(c[i]);
     while (analyze_stack.size() > 0) {
-        assert(reason(var(analyze_stack.last())) != CRef_Undef);
-        Clause& c = ca[reason(var(analyze_stack.last()))];
-        analyze_stack.pop(); // 
-        if (c.size() == 2 && value(c[0]) == l_False) {
-            assert(value(c[1]) == l_True);
-            Lit tmp = c[0];
-            c[0] = c[1], c[1] = tmp;
+        Var x = var(analyze_stack.last());
+        if (seen[x] == 2) {
+            assert(reason(x) != CRef_Undef);
+            seen[x] = 3;
+            const Clause& r = ca[reason(x)];
+            for (int i = 0; i < r.size(); i++)
+                if (var(r[i]) != x)
+                    lratVisit(r[i]);
+        } else {
+            analyze_stack.pop();
+            if (seen[x] == 3) {
+                seen[x] = 1;
+                lratChain.push(ca.id(ca[reason(x)]));
+            }
         }
+    }
+    lratChain.push(ca.id(c));
 
-        for (int i = 1; i < c.size(); i++) {
-            Lit p = c[i];
-            if (!seen[var(p)]) {
-                if (level(var(p)) > 0) {
-                    if (reason(var(p)) != CRef_Undef && (abstractLevel(var(p)) & abstract_levels) != 0) {
-                        seen[var(p)] = 1;
-                        analyze_stack.push(p);
-                        analyze_toclear.push(p);
-                    } else {
-                        for (int j = top; j < analyze_toclear.size(); j++)
-                            seen[var(analyze_toclear[j])] = 0;
-                        analyze_toclear.shrink(analyze_toclear.size() - top);
-                        return false;
-                    }
-                }
-            }
+    for (int i = 0; i < analyze_toclear.size(); i++) seen[var(analyze_toclear[i])] = 0;
+    analyze_toclear.clear();
+}
+
+
+void Solver::lratVisit(Lit q) {
+    Var x = var(q);
+    if (seen[x] == 1) return;
+    assert(seen[x] != 3); // (the implication graph has no cycle)
+    if (seen[x] == 0) {
+        seen[x] = 2;
+        analyze_toclear.push(q);
+        if (level(x) == 0) {
+            seen[x] = 1;
+            lratChain.push(lratUnit[x]);
+            return;
         }
     }
+    analyze_stack.push(q);
+}
 
-    return true;
+
+// Units of level 0 are derived in trail order, each from its reason and the units of the other
+// literals of the reason. This must be done before the reason is removed (see 'simplify()').
+
+void Solver::lratDeriveUnits() {
+    int end = decisionLevel() == 0 ? trail.size() : trail_lim[0];
+    for (; lratUnitsDone < end; lratUnitsDone++) {
+        Lit p = trail[lratUnitsDone];
+        if (lratUnit[var(p)] != 0) continue; // (input or learnt unit)
+        assert(reason(var(p)) != CRef_Undef);
+        const Clause& c = ca[reason(var(p))];
+        lratChain.clear();
+        for (int i = 0; i < c.size(); i++)
+            if (var(c[i]) != var(p))
+                lratChain.push(lratUnit[var(c[i])]);
+        lratChain.push(ca.id(c));
+        add_tmp.clear();
+        add_tmp.push(p);
+        lratUnit[var(p)] = ++lratLastId;
+        proof().addClause(lratLastId, add_tmp, lratChain);
+    }
+}
+
+
+void Solver::lratRootConflict(CRef confl) {
+    const Clause& c = ca[confl];
+    lratConflict.clear();
+    for (int i = 0; i < c.size(); i++)
+        lratConflict.push(c[i]);
+    lratConflictId = ca.id(c);
+}
+
+
+void Solver::lratEmptyClause() {
+    lratDeriveUnits();
+    lratChain.clear();
+    for (int i = 0; i < lratConflict.size(); i++)
+        lratChain.push(lratUnit[var(lratConflict[i])]);
+    lratChain.push(lratConflictId);
+    lratConflict.clear();
+    proof().addClause(++lratLastId, lratConflict, lratChain);
 }
 
 
@@ -894,11 +1476,11 @@ void Solver::analyzeFinal(Lit p, vec<Lit>& out_conflict) {
                 assert(level(x) > 0);
                 out_conflict.push(~trail[i]);
             } else {
-                Clause& c = ca[reason(x)];
+                Clause& c = ca[explain(x)];
                 //                for (int j = 1; j < c.size(); j++) Minisat (glucose 2.0) loop 
                 // Bug in case of assumptions due to special data structures for Binary.
                 // Many thanks to Sam Bayless (sbayless@cs.ubc.ca) for discover this bug.
-                for (int j = ((c.size() == 2) ? 0 : 1); j < c.size(); j++)
+                for (int j = ((c.size() <= 3) ? 0 : 1); j < c.size(); j++)
                     if (level(var(c[j])) > 0)
                         seen[var(c[j])] = 1;
             }
@@ -913,7 +1495,8 @@ void Solver::analyzeFinal(Lit p, vec<Lit>& out_conflict) {
 void Solver::uncheckedEnqueue(Lit p, CRef from) {
     assert(value(p) == l_Undef);
     assigns[var(p)] = lbool(!sign(p));
-    vardata[var(p)] = mkVarData(from, decisionLevel());
+    vardata[var(p)].reason = from;
+    vardata[var(p)].level = decisionLevel();
     trail.push_(p);
 }
 
@@ -927,13 +1510,39 @@ void Solver::uncheckedEnqueue(Lit p, CRef from) {
 |  
 |    Post-conditions:
 |      * the propagation queue is empty, even if there was a conflict.
+|
+|    The mode of the solver is a template parameter of 'propagate_()', so that each one gets its
+|    own loop without the tests: 'Incremental' for the selectors of the incremental mode,
+|    'UnaryWatched' for the unary watches of the parallel solvers.
+|
+|    The XOR constraints, then the external propagator, are propagated at the fixpoint of the
+|    clauses, until none of them implies anything more.
 |________________________________________________________________________________________________@*/
 CRef Solver::propagate() {
+    CRef confl;
+    for (;;) {
+        if (incremental)
+            confl = useUnaryWatched ? propagate_<true, true>() : propagate_<true, false>();
+        else
+            confl = useUnaryWatched ? propagate_<false, true>() : propagate_<false, false>();
+        if (confl == CRef_Undef && xorMatrix.size() > 0)
+            confl = propagateXors();
+        if (confl == CRef_Undef && qhead == trail.size() && propagator != NULL)
+            confl = propagateExternal();
+        if (confl != CRef_Undef || qhead == trail.size())
+            return confl;
+    }
+}
+
+template<bool Incremental, bool UnaryWatched>
+CRef Solver::propagate_() {
+    TIME_PHASE(phaseTimers, phase_propagate);
     CRef confl = CRef_Undef;
     int num_props = 0;
     int previousqhead = qhead;
     watches.cleanAll();
     watchesBin.cleanAll();
+    watchesTer.cleanAll();
     unaryWatches.cleanAll();
     while (qhead < trail.size()) {
         Lit p = trail[qhead++]; // 'p' is enqueued fact to propagate.
@@ -941,6 +1550,20 @@ CRef Solver::propagate() {
         Watcher *i, *j, *end;
         num_props++;
 
+#ifdef PREFETCH_PROPAGATION
+        // Watch lists of the next literals: the contents for the nearest one, the headers beyond
+        if (qhead < trail.size()) {
+            Lit q = trail[qhead];
+            __builtin_prefetch((Watcher*)watchesBin[q]);
+            __builtin_prefetch((Watcher*)watches[q]);
+            if (qhead + PREFETCH_TRAIL_DISTANCE < trail.size()) {
+                q = trail[qhead + PREFETCH_TRAIL_DISTANCE];
+                __builtin_prefetch(&watchesBin[q]);
+                __builtin_prefetch(&watches[q]);
+            }
+        }
+#endif
+
 
         // First, Propagate binary clauses 
         vec<Watcher>& wbin = watchesBin[p];
@@ -958,8 +1581,40 @@ CRef Solver::propagate() {
             }
         }
 
+        // Then ternary clauses, without looking at the clauses themselves
+        vec<TernaryWatcher>& wter = watchesTer[p];
+        for (int k = 0; k < wter.size(); k++) {
+            lbool v1 = value(wter[k].other1);
+            lbool v2 = value(wter[k].other2);
+            if (v1 == l_True || v2 == l_True)
+                continue;
+
+            if (v1 == l_False) {
+                if (v2 == l_False) {
+                    confl = wter[k].cref;
+                    qhead = trail.size();
+                    break;
+                }
+                uncheckedEnqueue(wter[k].other2, wter[k].cref);
+            } else if (v2 == l_False)
+                uncheckedEnqueue(wter[k].other1, wter[k].cref);
+        }
+        if (confl != CRef_Undef)
+            break;
+
+        // Then the cardinality constraints (see 'addAtMost_()')
+        if (cards.size() > 0 && (confl = propagateCards(p)) != CRef_Undef) {
+            qhead = trail.size();
+            break;
+        }
+
         // Now propagate other 2-watched clauses
         for (i = j = (Watcher*) ws, end = i + ws.size(); i != end;) {
+#ifdef PREFETCH_PROPAGATION
+            // The clause of a watcher further on will be inspected if its blocker is not true:
+            if (end - i > PREFETCH_WATCH_DISTANCE && value(i[PREFETCH_WATCH_DISTANCE].blocker) != l_True)
+                __builtin_prefetch(ca.lea(i[PREFETCH_WATCH_DISTANCE].cref));
+#endif
             // Try to avoid inspecting the clause:
             Lit blocker = i->blocker;
             if (value(blocker) == l_True) {
@@ -985,7 +1640,7 @@ CRef Solver::propagate() {
                 *j++ = w;
                 continue;
             }
-	    if(incremental) { // ----------------- INCREMENTAL MODE
+	    if(Incremental) { // ----------------- INCREMENTAL MODE
 	      int choosenPos = -1;
 	      for (int k = 2; k < c.size(); k++) {
 		
@@ -996,7 +1651,7 @@ CRef Solver::propagate() {
 		  } else {
 		    choosenPos = k;
 		    
-		    if(value(c[k])==l_True || !isSelector(var(c[k]))) {
+		    if(value(c[k])==l_True || !isSelector_<Incremental>(var(c[k]))) {
 		      break;
 		    }
 		  }
@@ -1036,7 +1691,7 @@ NextClause:
         ws.shrink(i - j);
 
        // unaryWatches "propagation"
-        if (useUnaryWatched &&  confl == CRef_Undef) {
+        if (UnaryWatched &&  confl == CRef_Undef) {
             confl = propagateUnaryWatches(p);
 
         }
@@ -1126,7 +1781,7 @@ CRef Solver::propagateUnaryWatches(Lit p) {
             //Override :-(
             //goodImportsFromThreads[ca[cr].importedFrom()]++;
             ca[cr].setOneWatched(false);
-            ca[cr].setExported(2);  
+            ca.setExported(ca[cr], 2);  
         }
 NextClauseUnary:
         ;
@@ -1136,6 +1791,421 @@ NextClauseUnary:
     return confl;
 }
 
+/*_________________________________________________________________________________________________
+|
+|  propagateCards : [Lit]  ->  [Clause*]
+|  
+|  Description:
+|    Propagates the cardinality constraints containing 'p', which has just become true. Returns
+|    a conflicting clause (built from 'p' and 'k' other true literals), otherwise CRef_Undef.
+|
+|    'p' is counted in the 'ntrue' of its constraints ('cancelUntil()' takes it back), and a
+|    constraint is only inspected once this count reaches 'k'. It then counts the literals true
+|    in the trail, which may be ahead of 'qhead'. After a conflict, the other counts are still
+|    updated, so that they stay in line with 'cardTrailHead'.
+|________________________________________________________________________________________________@*/
+CRef Solver::propagateCards(Lit p) {
+    assert(trail[qhead - 1] == p);
+    vec<int>& ws = watchesCard[p];
+    CRef confl = CRef_Undef;
+    for (int i = 0; i < ws.size(); i++) {
+        CardConstraint& c = cards[ws[i]];
+        if (++c.ntrue < c.k || confl != CRef_Undef)
+            continue;
+        const Lit* lits = &cardLits[c.start];
+        int ntrue = 0;
+        for (int j = 0; j < c.size && ntrue <= c.k; j++)
+            if (value(lits[j]) == l_True)
+                ntrue++;
+
+        if (ntrue > c.k) {
+            vec<Lit> ps;
+            ps.push(~p);
+            for (int j = 0; ps.size() <= c.k; j++)
+                if (lits[j] != p && value(lits[j]) == l_True)
+                    ps.push(~lits[j]);
+            nbCardExplanations++;
+            confl = addExplanation(ps);
+        } else
+            for (int j = 0; j < c.size; j++)
+                if (value(lits[j]) == l_Undef) {
+                    uncheckedEnqueue(~lits[j], CRef_Card);
+                    cardReason[var(lits[j])] = ws[i];
+                    nbCardPropagations++;
+                }
+    }
+    cardTrailHead = qhead;
+    return confl;
+}
+
+
+// The first literal of 'ps' stays in front (the implied one, or the one being propagated for a
+// conflict), the one of highest level among the other ones is watched with it.
+CRef Solver::addExplanation(vec<Lit>& ps) {
+    int max_i = 1;
+    for (int i = 2; i < ps.size(); i++)
+        if (level(var(ps[i])) > level(var(ps[max_i])))
+            max_i = i;
+    Lit q = ps[max_i]; ps[max_i] = ps[1]; ps[1] = q;
+
+    CRef cr = ca.alloc(ps, true);
+    ca[cr].setOneWatched(false);
+    ca[cr].setSizeWithoutSelectors(ps.size());
+    ca.setLBD(ca[cr], computeLBD(ca[cr]));
+    learnts.push(cr);
+    attachClause(cr);
+    return cr;
+}
+
+
+// When 'x' was implied, exactly 'k' literals of the constraint were true, and they stay the only
+// true ones as long as 'x' is assigned (all the other ones were implied false with it).
+CRef Solver::explainCard(Var x) {
+    const CardConstraint& c = cards[cardReason[x]];
+    const Lit* lits = &cardLits[c.start];
+    vec<Lit> ps;
+    ps.push(lit_Undef);
+    for (int j = 0; j < c.size; j++)
+        if (var(lits[j]) == x)
+            ps[0] = ~lits[j];
+        else if (value(lits[j]) == l_True)
+            ps.push(~lits[j]);
+    assert(ps[0] != lit_Undef && value(ps[0]) == l_True && ps.size() == c.k + 1);
+
+    nbCardExplanations++;
+    return vardata[x].reason = addExplanation(ps);
+}
+
+/*_________________________________________________________________________________________________
+|
+|  addXor : (vs : const vec<Var>&) (rhs : bool)  ->  [bool]
+|  
+|  Description:
+|    Adds the constraint 'vs[0] + ... + vs[n-1] = rhs (mod 2)', to be propagated by Gauss-Jordan
+|    elimination (see 'propagateXors()'). The clauses must imply it: they stay the reference for
+|    the simplification and when the elimination is off. The matrix is built (again) at the next
+|    call to 'solve()'.
+|________________________________________________________________________________________________@*/
+bool Solver::addXor(const vec<Var>& vs, bool rhs) {
+    assert(decisionLevel() == 0);
+    if (!useGauss || certifiedUNSAT) return false;
+
+    for (int i = 0; i < vs.size(); i++)
+        xorVars.push(vs[i]);
+    xorVars.push(var_Undef);
+    xorRhs.push(rhs);
+    xorMatrix.clear();
+    return true;
+}
+
+
+void Solver::buildXorMatrix() {
+    for (int i = 0; i < xorColVar.size(); i++)
+        xorVarCol[xorColVar[i]] = -1;
+    xorColVar.clear();
+    for (int i = 0; i < xorVars.size(); i++)
+        if (xorVars[i] != var_Undef && xorVarCol[xorVars[i]] < 0) {
+            xorVarCol[xorVars[i]] = xorColVar.size();
+            xorColVar.push(xorVars[i]);
+        }
+
+    if (xorColVar.size() > gaussMaxVars) {
+        if (verbosity >= 1)
+            printf("c Too many variables in XOR constraints (%d)... No Gauss-Jordan elimination\n", xorColVar.size());
+        for (int i = 0; i < xorColVar.size(); i++)
+            xorVarCol[xorColVar[i]] = -1;
+        xorColVar.clear(true);
+        xorVars.clear(true);
+        xorRhs.clear(true);
+        return;
+    }
+
+    // Row 'r' is 'xorMatrix[r*xorWords .. (r+1)*xorWords-1]', the bit of column 'c' is the bit
+    // 'c % 64' of its word 'c / 64' (a variable twice in a constraint cancels out):
+    xorWords = (xorColVar.size() + 63) / 64;
+    xorMatrix.growTo(xorRhs.size() * xorWords, 0);
+    for (int i = 0, r = 0; i < xorVars.size(); i++)
+        if (xorVars[i] == var_Undef)
+            r++;
+        else {
+            int c = xorVarCol[xorVars[i]];
+            xorMatrix[r * xorWords + c / 64] ^= (uint64_t)1 << (c % 64);
+        }
+    xorMatrix.copyTo(xorRows);
+    xorRhs.copyTo(xorRowsRhs);
+    xorPivot.clear();
+    xorPivot.growTo(xorRhs.size(), -1);
+    xorAssigned.growTo(xorWords);
+    xorTrue.growTo(xorWords);
+    xorReason.growTo(xorColVar.size() * xorWords);
+    xorTrailHead = -1;
+}
+
+/*_________________________________________________________________________________________________
+|
+|  propagateXors : [void]  ->  [Clause*]
+|  
+|  Description:
+|    Gauss-Jordan elimination of the unassigned columns in the matrix of the XOR constraints,
+|    with the current assignment. A row without unassigned column and of the wrong parity is a
+|    conflict (returned as a clause), a row with a single one implies its variable, with
+|    'CRef_Xor' as reason: each row is a combination of the original constraints, and the one
+|    of the implication is saved in 'xorReason' to build the clause on demand (see 'explain()').
+|    Since this is done at each fixpoint of the propagation, nothing can be implied at a lower
+|    level than the current one.
+|
+|    The elimination only runs when a variable of the matrix was assigned since the last one,
+|    and it is kept in 'xorRows' from one call to the next: only the rows whose pivot has been
+|    assigned take a new one. Backtracking leaves it as it is, since any equivalent matrix where
+|    each pivot is only in its row will do.
+|________________________________________________________________________________________________@*/
+CRef Solver::propagateXors() {
+    if (xorTrailHead >= 0) {
+        int i = xorTrailHead;
+        while (i < trail.size() && xorVarCol[var(trail[i])] < 0) i++;
+        xorTrailHead = trail.size();
+        if (i == trail.size()) return CRef_Undef;
+    }
+    xorTrailHead = trail.size();
+
+    TIME_PHASE(phaseTimers, phase_propagate);
+    nbGaussEliminations++;
+    int W = xorWords, nrows = xorRhs.size(), ncols = xorColVar.size();
+    for (int w = 0; w < W; w++)
+        xorAssigned[w] = xorTrue[w] = 0;
+    for (int c = 0; c < ncols; c++) {
+        lbool v = value(xorColVar[c]);
+        if (v != l_Undef) {
+            xorAssigned[c / 64] |= (uint64_t)1 << (c % 64);
+            if (v == l_True) xorTrue[c / 64] |= (uint64_t)1 << (c % 64);
+        }
+    }
+
+    // A row with an unassigned column gets one as pivot if its own is assigned (or missing):
+    for (int p = 0; p < nrows; p++) {
+        int c = xorPivot[p];
+        if (c >= 0 && !(xorAssigned[c / 64] & ((uint64_t)1 << (c % 64)))) continue;
+
+        uint64_t* pivot = &xorRows[p * W];
+        c = -1;
+        for (int k = 0; k < W && c < 0; k++)
+            if (uint64_t undef = pivot[k] & ~xorAssigned[k])
+                c = k * 64 + __builtin_ctzll(undef);
+        if (c < 0) continue;
+
+        int w = c / 64;
+        uint64_t bit = (uint64_t)1 << (c % 64);
+        for (int r = 0; r < nrows; r++)
+            if (r != p && (xorRows[r * W + w] & bit)) {
+                uint64_t* row = &xorRows[r * W];
+                for (int k = 0; k < W; k++) row[k] ^= pivot[k];
+                xorRowsRhs[r] ^= xorRowsRhs[p];
+            }
+        xorPivot[p] = c;
+    }
+
+    // The rows without an unassigned pivot have no unassigned column left:
+    for (int r = 0; r < nrows; r++) {
+        int c = xorPivot[r];
+        if (c >= 0 && !(xorAssigned[c / 64] & ((uint64_t)1 << (c % 64)))) continue;
+        const uint64_t* row = &xorRows[r * W];
+        int parity = xorRowsRhs[r];
+        for (int k = 0; k < W; k++)
+            parity ^= __builtin_popcountll(row[k] & xorTrue[k]) & 1;
+        if (!parity) continue;
+
+        // Conflict: all the variables of the row are false in the clause
+        nbXorConflicts++;
+        if (decisionLevel() == 0) return CRef_Xor;
+        vec<Lit> ps;
+        for (int c = 0; c < ncols; c++)
+            if (row[c / 64] & ((uint64_t)1 << (c % 64)))
+                ps.push(mkLit(xorColVar[c], value(xorColVar[c]) == l_True));
+        int max_i = 0;
+        for (int i = 1; i < ps.size(); i++)
+            if (level(var(ps[i])) > level(var(ps[max_i])))
+                max_i = i;
+        Lit q = ps[max_i]; ps[max_i] = ps[0]; ps[0] = q;
+        assert(ps.size() > 1 && level(var(ps[0])) == decisionLevel());
+        nbXorExplanations++;
+        return addExplanation(ps);
+    }
+
+    // The rows with their pivot as only unassigned column imply it:
+    for (int r = 0; r < nrows; r++) {
+        int c = xorPivot[r];
+        if (c < 0 || (xorAssigned[c / 64] & ((uint64_t)1 << (c % 64)))) continue;
+        const uint64_t* row = &xorRows[r * W];
+        int nundef = 0, parity = xorRowsRhs[r], col = -1;
+        for (int k = 0; k < W && nundef < 2; k++) {
+            uint64_t undef = row[k] & ~xorAssigned[k];
+            if (undef) {
+                nundef += __builtin_popcountll(undef);
+                col = k * 64 + __builtin_ctzll(undef);
+            }
+            parity ^= __builtin_popcountll(row[k] & xorTrue[k]) & 1;
+        }
+        if (nundef != 1) continue;
+
+        Var x = xorColVar[col];
+        nbXorPropagations++;
+        if (decisionLevel() == 0)
+            uncheckedEnqueue(mkLit(x, !parity));
+        else {
+            uncheckedEnqueue(mkLit(x, !parity), CRef_Xor);
+            for (int k = 0; k < W; k++)
+                xorReason[col * W + k] = row[k];
+        }
+    }
+    return CRef_Undef;
+}
+
+
+CRef Solver::explainXor(Var x) {
+    int col = xorVarCol[x];
+    const uint64_t* row = &xorReason[col * xorWords];
+    vec<Lit> ps;
+    ps.push(mkLit(x, value(x) == l_False));
+    for (int c = 0; c < xorColVar.size(); c++)
+        if (c != col && (row[c / 64] & ((uint64_t)1 << (c % 64))))
+            ps.push(mkLit(xorColVar[c], value(xorColVar[c]) == l_True));
+    assert(ps.size() > 1);
+
+    nbXorExplanations++;
+    return vardata[x].reason = addExplanation(ps);
+}
+
+/*_________________________________________________________________________________________________
+|
+|  connectPropagator : (p : ExternalPropagator*)  ->  [void]
+|  
+|  Description:
+|    Connects an external propagator (see 'ExternalPropagator'), notified of the assignments of
+|    the observed variables at the next propagation (those at level 0 included).
+|________________________________________________________________________________________________@*/
+void Solver::connectPropagator(ExternalPropagator* p) {
+    if (p != NULL && certifiedUNSAT) {
+        printf("Can not use an external propagator and certified unsat in the same time\n");
+        exit(1);
+    }
+    propagator = p;
+    extTrailHead = 0;
+}
+
+
+void Solver::observe(Var v) {
+    observed[v] = 1;
+}
+
+/*_________________________________________________________________________________________________
+|
+|  propagateExternal : [void]  ->  [Clause*]
+|  
+|  Description:
+|    Notifies the external propagator of the new assignments of the observed variables, then adds
+|    its clauses and enqueues the literals it implies, with 'CRef_Ext' as reason: the clause
+|    explaining an implication is only asked for if the conflict analysis reaches it (see
+|    'explain()'). Returns a conflicting clause, otherwise CRef_Undef.
+|
+|    A clause may make the solver backtrack (see 'addExternalClause()').
+|________________________________________________________________________________________________@*/
+CRef Solver::propagateExternal() {
+    for (; extTrailHead < trail.size(); extTrailHead++) {
+        Lit p = trail[extTrailHead];
+        if (observed[var(p)])
+            propagator->notifyAssignment(p, level(var(p)));
+    }
+
+    vec<Lit> ps;
+    CRef confl;
+    while (propagator->addClause(ps)) {
+        nbExtClauses++;
+        if ((confl = addExternalClause(ps, false)) != CRef_Undef)
+            return confl;
+        ps.clear();
+    }
+
+    for (Lit p; (p = propagator->propagate()) != lit_Undef;) {
+        if (value(p) == l_True)
+            continue;
+        if (value(p) == l_Undef) {
+            uncheckedEnqueue(p, CRef_Ext);
+            nbExtPropagations++;
+            continue;
+        }
+        // 'p' is false: its reason is the conflict
+        ps.clear();
+        propagator->reason(p, ps);
+        nbExtExplanations++;
+        return addExternalClause(ps, true);
+    }
+    return CRef_Undef;
+}
+
+
+// The literals of the clause are ordered: true ones, unassigned ones, then false ones by decreasing
+// level, and the first two are watched. If all of them are false, the solver backtracks to their
+// highest level (so that the conflict analysis finds one at the current level) and the clause is
+// returned. If one is unassigned, it is implied. A unit clause is added at level 0.
+CRef Solver::addExternalClause(vec<Lit>& ps, bool learnt) {
+    sort(ps);
+    Lit p; int i, j;
+    for (i = j = 0, p = lit_Undef; i < ps.size(); i++)
+        if (ps[i] == ~p)
+            return CRef_Undef;
+        else if (ps[i] != p)
+            ps[j++] = p = ps[i];
+    ps.shrink(i - j);
+
+    vec<int> rank(ps.size());
+    for (i = 0; i < ps.size(); i++)
+        rank[i] = value(ps[i]) == l_True ? INT32_MAX : value(ps[i]) == l_Undef ? INT32_MAX - 1 : level(var(ps[i]));
+    for (i = 1; i < ps.size(); i++)
+        for (j = i; j > 0 && rank[j - 1] < rank[j]; j--) {
+            int r = rank[j]; rank[j] = rank[j - 1]; rank[j - 1] = r;
+            p = ps[j]; ps[j] = ps[j - 1]; ps[j - 1] = p;
+        }
+
+    if (ps.size() <= 1) {
+        cancelUntil(0);
+        if (ps.size() == 0 || value(ps[0]) == l_False)
+            return CRef_Ext; // Conflict at level 0
+        if (value(ps[0]) == l_Undef)
+            uncheckedEnqueue(ps[0]);
+        return CRef_Undef;
+    }
+
+    CRef cr;
+    if (learnt)
+        cr = addExplanation(ps);
+    else {
+        cr = ca.alloc(ps, false);
+        clauses.push(cr);
+        attachClause(cr);
+    }
+
+    if (value(ps[0]) == l_False) {
+        cancelUntil(level(var(ps[0])));
+        return cr;
+    }
+    if (value(ps[0]) == l_Undef && value(ps[1]) == l_False)
+        uncheckedEnqueue(ps[0], cr);
+    return CRef_Undef;
+}
+
+
+CRef Solver::explainExternal(Var x) {
+    Lit p = mkLit(x, value(x) == l_False);
+    vec<Lit> ps;
+    propagator->reason(p, ps);
+    for (int i = 0; i < ps.size(); i++)
+        if (ps[i] == p) { ps[i] = ps[0]; ps[0] = p; }
+    assert(ps.size() > 1 && ps[0] == p);
+
+    nbExtExplanations++;
+    return vardata[x].reason = addExplanation(ps);
+}
+
 /*_________________________________________________________________________________________________
 |
 |  reduceDB : ()  ->  [void]
@@ -1148,31 +2218,37 @@ NextClauseUnary:
 
 void Solver::reduceDB()
 {
- 
+  TIME_PHASE(phaseTimers, phase_reduceDB);
   int     i, j;
   nbReduceDB++;
+#ifdef LEARNTS_METADATA_TABLE
+  ca.sortLearnts(learnts, false);
+#else
   sort(learnts, reduceDB_lt(ca));
+#endif
 
-  // We have a lot of "good" clauses, it is difficult to compare them. Keep more !
-  if(ca[learnts[learnts.size() / RATIOREMOVECLAUSES]].lbd()<=3) nbclausesbeforereduce +=specialIncReduceDB; 
+  // We have a lot of "good" clauses, it is difficult to compare them. Keep more ! (unless the memory is short)
+  if(mem_pressure == 0 && ca.lbd(ca[learnts[learnts.size() / RATIOREMOVECLAUSES]])<=3) nbclausesbeforereduce +=specialIncReduceDB; 
   // Useless :-)
-  if(ca[learnts.last()].lbd()<=5)  nbclausesbeforereduce +=specialIncReduceDB; 
+  if(mem_pressure == 0 && ca.lbd(ca[learnts.last()])<=5)  nbclausesbeforereduce +=specialIncReduceDB; 
   
   
   // Don't delete binary or locked clauses. From the rest, delete clauses from the first half
   // Keep clauses which seem to be usefull (their lbd was reduce during this sequence)
+  // Close to the memory budget: delete three quarters, the clauses of LBD 2 and the kept ones included
 
-  int limit = learnts.size() / 2;
+  int limit = mem_pressure >= 2 ? learnts.size() * 3 / 4 : learnts.size() / 2;
+  unsigned int glue = mem_pressure >= 2 ? 1 : 2;
 
   for (i = j = 0; i < learnts.size(); i++){
     Clause& c = ca[learnts[i]];
-    if (c.lbd()>2 && c.size() > 2 && c.canBeDel() &&  !locked(c) && (i < limit)) {
+    if (ca.lbd(c)>glue && c.size() > 2 && (ca.canBeDel(c) || mem_pressure >= 2) &&  !locked(c) && (i < limit)) {
       removeClause(learnts[i]);
       nbRemovedClauses++;
     }
     else {
-      if(!c.canBeDel()) limit++; //we keep c, so we can delete an other clause
-      c.setCanBeDel(true);       // At the next step, c can be delete
+      if(!ca.canBeDel(c)) limit++; //we keep c, so we can delete an other clause
+      ca.setCanBeDel(c, true);       // At the next step, c can be delete
       learnts[j++] = learnts[i];
     }
   }
@@ -1200,6 +2276,10 @@ void Solver::removeSatisfied(vec<CRef>& cs) {
 }
 
 void Solver::rebuildOrderHeap() {
+    if (useVMTF) {
+        vmtf_queue.reset();
+        return;
+    }
     vec<Var> vs;
     for (Var v = 0; v < nVars(); v++)
         if (decision[v] && value(v) == l_Undef)
@@ -1208,6 +2288,15 @@ void Solver::rebuildOrderHeap() {
 
 }
 
+
+// The queue which is not in use is not maintained: the VMTF queue keeps its order (the cursor is
+// reset), and the heap is rebuilt from the activities as they were when it was left.
+
+void Solver::switchDecisionQueue() {
+    useVMTF = !useVMTF;
+    rebuildOrderHeap();
+}
+
 /*_________________________________________________________________________________________________
 |
 |  simplify : [void]  ->  [bool]
@@ -1218,11 +2307,13 @@ void Solver::rebuildOrderHeap() {
 |________________________________________________________________________________________________@*/
 bool Solver::simplify() {
     assert(decisionLevel() == 0);
+    TIME_PHASE(phaseTimers, phase_simplify);
 
     if (!ok) return ok = false;
     else {
         CRef cr = propagate();
         if (cr != CRef_Undef) {
+            if (certifiedLRAT) lratRootConflict(cr);
             return ok = false;
         }
     }
@@ -1231,6 +2322,8 @@ bool Solver::simplify() {
     if (nAssigns() == simpDB_assigns || (simpDB_props > 0))
         return true;
 
+    if (certifiedLRAT) lratDeriveUnits(); // (before their reasons go away)
+
     // Remove satisfied clauses:
     removeSatisfied(learnts);
     removeSatisfied(unaryWatchedClauses);
@@ -1266,6 +2359,7 @@ lbool Solver::search(int nof_conflicts) {
     vec<Lit> learnt_clause, selectors;
     unsigned int nblevels,szWithoutSelectors = 0;
     bool blocked = false;
+    int stable_limit = stableMode ? stableRestartLimit() : 0;
     starts++;
     for (;;) {
         if (decisionLevel() == 0) { // We import clauses FIXME: ensure that we will import clauses enventually (restart after some point)
@@ -1297,13 +2391,17 @@ lbool Solver::search(int nof_conflicts) {
                         (int) nbReduceDB, nLearnts(), (int) nbDL2, (int) nbRemovedClauses, progressEstimate()*100);
             }
             if (decisionLevel() == 0) {
+                if (certifiedLRAT) lratRootConflict(confl);
                 return l_False;
 
             }
 
+            if (stableMode)
+                updateTargetPhases();
+
             trailQueue.push(trail.size());
             // BLOCK RESTART (CP 2012 paper)
-            if (conflictsRestarts > LOWER_BOUND_FOR_BLOCKING_RESTART && lbdQueue.isvalid() && trail.size() > R * trailQueue.getavg()) {
+            if (!stableMode && conflictsRestarts > LOWER_BOUND_FOR_BLOCKING_RESTART && lbdQueue.isvalid() && trail.size() > R * trailQueue.getavg()) {
                 lbdQueue.fastclear();
                 nbstopsrestarts++;
                 if (!blocked) {
@@ -1323,21 +2421,21 @@ lbool Solver::search(int nof_conflicts) {
 
             cancelUntil(backtrack_level);
 
-            if (certifiedUNSAT) {
-                for (int i = 0; i < learnt_clause.size(); i++)
-                    fprintf(certifiedOutput, "%i ", (var(learnt_clause[i]) + 1) *
-                        (-2 * sign(learnt_clause[i]) + 1));
-                fprintf(certifiedOutput, "0\n");
-            }
+            if (certifiedLRAT)
+                proof().addClause(++lratLastId, learnt_clause, lratChain);
+            else if (certifiedUNSAT)
+                proof().addClause(learnt_clause);
 
 
             if (learnt_clause.size() == 1) {
+                if (certifiedLRAT) lratUnit[var(learnt_clause[0])] = lratLastId;
                 uncheckedEnqueue(learnt_clause[0]);
                 nbUn++;
                 parallelExportUnaryClause(learnt_clause[0]);
             } else {
                 CRef cr = ca.alloc(learnt_clause, true);
-                ca[cr].setLBD(nblevels);
+                if (certifiedLRAT) ca.setId(ca[cr], lratLastId);
+                ca.setLBD(ca[cr], nblevels);
                 ca[cr].setOneWatched(false);
 		ca[cr].setSizeWithoutSelectors(szWithoutSelectors);
                 if (nblevels <= 2) nbDL2++; // stats
@@ -1356,8 +2454,10 @@ lbool Solver::search(int nof_conflicts) {
 
         } else {
             // Our dynamic restart, see the SAT09 competition compagnion paper 
-            if (
-                    (lbdQueue.isvalid() && ((lbdQueue.getavg() * K) > (sumLBD / conflictsRestarts)))) {
+            // (in stable mode: a number of conflicts given by stableRestartLimit())
+            // (also when out of budget: the solve_() loop stops at restarts)
+            if ((stableMode ? conflictC >= stable_limit :
+                    (lbdQueue.isvalid() && ((lbdQueue.getavg() * K) > (sumLBD / conflictsRestarts)))) || !withinBudget()) {
                 lbdQueue.fastclear();
                 progress_estimate = progressEstimate();
                 int bt = 0;
@@ -1372,6 +2472,10 @@ lbool Solver::search(int nof_conflicts) {
             if (decisionLevel() == 0 && !simplify()) {
                 return l_False;
             }
+            // Reduce the learnts (or give up) when the memory gets short:
+            if (mem_budget > 0 && conflicts >= mem_next_check)
+                checkMemory();
+
             // Perform clause database reduction !
             if (conflicts >= ((unsigned int) curRestart * nbclausesbeforereduce)) {
 
@@ -1405,6 +2509,16 @@ lbool Solver::search(int nof_conflicts) {
                 decisions++;
                 next = pickBranchLit();
                 if (next == lit_Undef) {
+                    // The external propagator may refute the model with a clause (added by 'propagate()'):
+#ifdef PACKED_VARDATA
+                    if (propagator != NULL){
+                        vec<lbool> values;
+                        for (int v = 0; v < nVars(); v++) values.push(value(v));
+                        if (!propagator->checkModel(values)) continue; }
+#else
+                    if (propagator != NULL && !propagator->checkModel(assigns))
+                        continue;
+#endif
                     printf("c last restart ## conflicts  :  %d %d \n", conflictC, decisionLevel());
                     // Model found:
                     return l_True;
@@ -1418,6 +2532,144 @@ lbool Solver::search(int nof_conflicts) {
     }
 }
 
+/*_________________________________________________________________________________________________
+|
+|  Stable mode and rephasing
+|  
+|  Description:
+|    With 'stableSearch', the search alternates between the focused mode (the dynamic LBD restarts
+|    above, with restart blocking) and a stable mode, in which restarts are rare and follow a Luby
+|    or geometric sequence, and decisions are taken with the target phases. The switch happens at
+|    restarts, each mode lasting 50% longer (in conflicts) than the previous one. The saved phases
+|    are also reset periodically in both modes (rephasing).
+|________________________________________________________________________________________________@*/
+
+// Finite subsequences of the Luby-sequence:
+//
+//   0: 1
+//   1: 1 1 2
+//   2: 1 1 2 1 1 2 4
+//   3: 1 1 2 1 1 2 4 1 1 2 1 1 2 4 8
+//   ...
+//
+
+static double luby(double y, int x) {
+
+    // Find the finite subsequence that contains index 'x', and the
+    // size of that subsequence:
+    int size, seq;
+    for (size = 1, seq = 0; size < x + 1; seq++, size = 2 * size + 1);
+
+    while (size - 1 != x) {
+        size = (size - 1) >> 1;
+        seq--;
+        x = x % size;
+    }
+
+    return pow(y, seq);
+}
+
+
+int Solver::stableRestartLimit() {
+    double limit = stableRestarts == 0 ? luby(2, modeRestarts) : pow(1.5, modeRestarts);
+    modeRestarts++;
+    limit *= stableUnit;
+    return limit < INT32_MAX ? (int)limit : INT32_MAX;
+}
+
+
+void Solver::updateTargetPhases() {
+    int assigned = trail_lim.last(); // (the conflict is at the last level)
+    if (assigned > targetAssigned) {
+        for (int i = 0; i < assigned; i++)
+            targetPolarity[var(trail[i])] = sign(trail[i]);
+        targetAssigned = assigned;
+    }
+    if (assigned > bestAssigned) {
+        for (int i = 0; i < assigned; i++)
+            bestPolarity[var(trail[i])] = sign(trail[i]);
+        bestAssigned = assigned;
+    }
+}
+
+
+// Rephasing cycles through: best, original, best, inverted, best, random.
+
+void Solver::rephase() {
+    static const char phases[] = "BOBIBW";
+    char kind = phases[nbRephases % 6];
+    nbRephases++;
+    nextRephase = conflicts + (uint64_t)rephaseInterval * (nbRephases + 1);
+
+    for (Var v = 0; v < nVars(); v++) {
+        switch (kind) {
+        case 'O': polarity[v] = true;  break; // (default of newVar())
+        case 'I': polarity[v] = false; break;
+        case 'B': if (bestPolarity[v] != 2) polarity[v] = bestPolarity[v]; break;
+        case 'W': if (!useLocalSearch) polarity[v] = drand(random_seed) < 0.5; break;
+        }
+        targetPolarity[v] = 2;
+    }
+    targetAssigned = 0;
+    if (kind == 'B') bestAssigned = 0;
+    if (kind == 'W' && useLocalSearch) localSearch();
+}
+
+
+void Solver::updateSearchMode() {
+    if (conflicts >= nextRephase)
+        rephase();
+
+    if (conflicts >= nextModeSwitch) {
+        stableMode = !stableMode;
+        modeRestarts = 0;
+        modeConflicts *= 1.5;
+        nextModeSwitch = conflicts + (uint64_t)modeConflicts;
+        targetAssigned = 0;
+        lbdQueue.fastclear();
+    }
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  localSearch : ()  ->  [void]
+|  
+|  Description:
+|    Run a probSAT local search (see 'LocalSearch') on the original clauses simplified by the
+|    assignments of level 0, starting from the saved phases, and save the best assignment found as
+|    phases. Learnt clauses are ignored. Must be called at level 0.
+|________________________________________________________________________________________________@*/
+void Solver::localSearch() {
+    if (decisionLevel() > 0) return;   // (incremental mode: the restarts may keep the assumptions)
+
+    LocalSearch ls(lsCb, (uint64_t)(drand(random_seed) * 4294967296.0) + 1);
+    for (Var v = 0; v < nVars(); v++)
+        ls.addVar(polarity[v]);
+
+    for (int i = 0; i < clauses.size(); i++) {
+        Clause& c = ca[clauses[i]];
+        if (satisfied(c)) continue;
+        add_tmp.clear();
+        for (int j = 0; j < c.size(); j++)
+            if (value(c[j]) == l_Undef)
+                add_tmp.push(c[j]);
+        if (add_tmp.size() > 0)        // (falsified by units not propagated yet: left to the search)
+            ls.addClause(add_tmp);
+    }
+
+    lsLastUnsat = ls.run(lsFlips);
+    for (Var v = 0; v < nVars(); v++)
+        if (value(v) == l_Undef)
+            polarity[v] = ls.phase(v);
+
+    nbLocalSearches++;
+    lsFlipsTotal += ls.flips;
+    if (verbosity >= 2)
+        printf("c local search: %d unsatisfied clauses after %" PRIu64" flips\n", lsLastUnsat, ls.flips);
+}
+
+
 double Solver::progressEstimate() const {
     double progress = 0;
     double F = 1.0 / nVars();
@@ -1431,6 +2683,69 @@ double Solver::progressEstimate() const {
     return progress / nVars();
 }
 
+
+void Solver::setTimeBudget(double seconds) {
+    deadline_checked   = realTime();
+    deadline           = deadline_checked + seconds;
+    deadline_countdown = 0;
+}
+
+
+void Solver::setMemBudget(double mb) {
+    mem_budget     = mb;
+    mem_pressure   = 0;
+    mem_next_check = conflicts;
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  checkMemory : ()  ->  [void]
+|  
+|  Description:
+|    Compare the resident memory to 'mem_budget' (every 1000 conflicts) and manage the learnts
+|    according to the pressure, so that a process under a memory limit answers later instead of
+|    dying:
+|      * above 75%: the interval between reductions stops growing (the panic mode of the parallel
+|        solver), and the garbage is collected earlier, in place, giving the pages back;
+|      * above 90%: the learnts are reduced at once (and at each check), three quarters of them,
+|        with only the binary clauses protected;
+|      * still above the budget at the next check: give up, 'withinBudget()' becomes false.
+|________________________________________________________________________________________________@*/
+void Solver::checkMemory() {
+    mem_next_check = conflicts + 1000;
+    double used = memResident();
+    int pressure = used < 0.75 * mem_budget ? 0 : used < 0.9 * mem_budget ? 1 : 2;
+    if (pressure == 2 && mem_pressure >= 2 && used >= mem_budget)
+        pressure = 3;
+    if (pressure != mem_pressure && (verbosity >= 2 || (verbosity >= 1 && pressure == 3)))
+        printf("c Memory pressure %d (%.1f Mb used, budget %.1f Mb)\n", pressure, used, mem_budget);
+    mem_pressure = pressure;
+
+    if (mem_pressure == 2 && learnts.size() > 0) {
+        reduceDB();
+        garbageCollect();
+    }
+}
+
+
+// Read the clock when the countdown of withinBudget() or interrupted() is over, and calibrate the
+// next countdown so that the clock is read about every 10ms, whatever the cost of a search step:
+bool Solver::withinDeadline() const {
+    double now = realTime();
+    if (now >= deadline) {
+        deadline_countdown = 0;
+        return false;
+    }
+    if (now - deadline_checked < 0.005 && deadline_interval < (1 << 20))
+        deadline_interval *= 2;
+    else if (now - deadline_checked > 0.02 && deadline_interval > 1)
+        deadline_interval /= 2;
+    deadline_checked   = now;
+    deadline_countdown = deadline_interval;
+    return true;
+}
+
 void Solver::printIncrementalStats() {
 
     printf("c---------- Glucose Stats -------------------------\n");
@@ -1447,10 +2762,41 @@ void Solver::printIncrementalStats() {
 
   printf("\nc SAT Calls             : %d in %g seconds\n",nbSatCalls,totalTime4Sat);
   printf("c UNSAT Calls           : %d in %g seconds\n",nbUnsatCalls,totalTime4Unsat);
+#ifdef PROFILE_PHASES
+    phaseTimers.print();
+    printf("c phase times (JSON)    : "); phaseTimers.printJSON(stdout); printf("\n");
+#endif
 
     printf("c--------------------------------------------------\n");
 }
 
+/*_________________________________________________________________________________________________
+|
+|  printStatsJSON : (out : FILE*) (call : int) (result : lbool)  ->  [void]
+|  
+|  Description:
+|    Write the statistics as one line of JSON, for scripts. The schema is shared with glucose-syrup,
+|    lingeling and zchaff (the keys may be extended, never renamed):
+|      schema, solver, event, call (number of the solve call, from 1), result (SAT, UNSAT or UNKNOWN),
+|      counters (conflicts, decisions, propagations, restarts, vars, clauses, learnts...),
+|      timings  (cpu, in seconds, and the time in each phase, 0 unless compiled with PROFILE_PHASES),
+|      memory   (mb, peak_mb, in megabytes).
+|________________________________________________________________________________________________@*/
+void Solver::printStatsJSON(FILE* out, int call, lbool result) {
+    fprintf(out, "{\"schema\": 1, \"solver\": \"glucose\", \"event\": \"solve\", \"call\": %d, \"result\": \"%s\", ",
+            call, result == l_True ? "SAT" : result == l_False ? "UNSAT" : "UNKNOWN");
+    fprintf(out, "\"counters\": {\"conflicts\": %" PRIu64", \"decisions\": %" PRIu64", \"propagations\": %" PRIu64", \"restarts\": %" PRIu64", ",
+            conflicts, decisions, propagations, starts);
+    fprintf(out, "\"vars\": %d, \"clauses\": %d, \"learnts\": %d, \"blocked_restarts\": %" PRIu64", \"reduce_db\": %" PRIu64", ",
+            nVars(), nClauses(), nLearnts(), nbstopsrestarts, nbReduceDB);
+    fprintf(out, "\"removed_clauses\": %" PRIu64", \"learnts_glue\": %" PRIu64", \"learnts_binary\": %" PRIu64", \"learnts_unit\": %" PRIu64"}, ",
+            nbRemovedClauses, nbDL2, nbBin, nbUn);
+    fprintf(out, "\"timings\": {\"cpu\": %.3f, \"phases\": ", cpuTime());
+    phaseTimers.printJSON(out);
+    fprintf(out, "}, \"memory\": {\"mb\": %.1f, \"peak_mb\": %.1f}}\n", memUsed(), memUsedPeak());
+    fflush(out);
+}
+
 // NOTE: assumptions passed in member-variable 'assumptions'.
 
 lbool Solver::solve_(bool do_simp, bool turn_off_simp) // Parameters are useless in core but useful for SimpSolver....
@@ -1467,6 +2813,10 @@ lbool Solver::solve_(bool do_simp, bool turn_off_simp) // Parameters are useless
     double curTime = cpuTime();
 
     solves++;
+
+    // (the previous call may have given up on the memory budget: try again)
+    if (mem_pressure == 3) mem_pressure = 2;
+    mem_next_check = conflicts;
             
    
     
@@ -1491,22 +2841,35 @@ lbool Solver::solve_(bool do_simp, bool turn_off_simp) // Parameters are useless
       printf("c =========================================================================================================\n");
     }
 
+    if (useGauss && xorMatrix.size() == 0 && xorRhs.size() > 0)
+        buildXorMatrix();
+
     // Search:
     int curr_restarts = 0;
+    if (useLocalSearch && status == l_Undef)
+        localSearch();
     while (status == l_Undef){
       status = search(0); // the parameter is useless in glucose, kept to allow modifications
 
         if (!withinBudget()) break;
         curr_restarts++;
+        if (decisionQueue == 2 && curr_restarts % queueSwitchRestarts == 0)
+            switchDecisionQueue();
+        if (stableSearch)
+            updateSearchMode();
+        if (useLocalSearch && lsRestarts > 0 && curr_restarts % lsRestarts == 0)
+            localSearch();
     }
 
     if (!incremental && verbosity >= 1)
       printf("c =========================================================================================================\n");
 
-    if (certifiedUNSAT){ // Want certified output
-      if (status == l_False)
-	fprintf(certifiedOutput, "0\n");
-      fclose(certifiedOutput);
+    if (certifiedUNSAT){ // Want certified output (kept open for the next calls)
+      if (status == l_False && conflict.size() == 0 && certifiedLRAT)
+        lratEmptyClause();
+      else if (status == l_False && conflict.size() == 0)
+        proof().addEmptyClause();
+      proof().flush();
     }
 
 
@@ -1544,73 +2907,136 @@ lbool Solver::solve_(bool do_simp, bool turn_off_simp) // Parameters are useless
 //=================================================================================================
 // Writing CNF to DIMACS:
 // 
-// FIXME: this needs to be rewritten completely.
-
-static Var mapVar(Var x, vec<Var>& map, Var& max) {
-    if (map.size() <= x || map[x] == -1) {
-        map.growTo(x + 1, -1);
-        map[x] = max++;
-    }
-    return map[x];
+// Variables keep their index (the ones above the largest written are left out), so that the units,
+// learnts and models of the written formula can be matched with the original one.
+
+bool Solver::toDimacs(const char* file, const vec<Lit>& assumps, int max_lbd, bool full, bool binary) {
+    DimacsWriter w(binary);
+    if (!w.open(file))
+        return false;
+    writeDimacs(w, assumps, max_lbd, full);
+    return w.close();
 }
 
-void Solver::toDimacs(FILE* f, Clause& c, vec<Var>& map, Var& max) {
-    if (satisfied(c)) return;
-
-    for (int i = 0; i < c.size(); i++)
-        if (value(c[i]) != l_False)
-            fprintf(f, "%s%d ", sign(c[i]) ? "-" : "", mapVar(var(c[i]), map, max) + 1);
-    fprintf(f, "0\n");
+void Solver::toDimacs(FILE* f, const vec<Lit>& assumps) {
+    DimacsWriter w(false);
+    w.open(f);
+    writeDimacs(w, assumps, -1, false);
+    w.close();
 }
 
-void Solver::toDimacs(const char *file, const vec<Lit>& assumps) {
-    FILE* f = fopen(file, "wr");
-    if (f == NULL)
-        fprintf(stderr, "could not open file %s\n", file), exit(1);
-    toDimacs(f, assumps);
-    fclose(f);
-}
 
-void Solver::toDimacs(FILE* f, const vec<Lit>& assumps) {
+/*_________________________________________________________________________________________________
+|
+|  writeDimacs : (w : DimacsWriter&) (assumps : const vec<Lit>&) (max_lbd : int) (full : bool)  ->  [void]
+|  
+|  Description:
+|    Write the clauses and cardinality constraints that are not satisfied at level 0, without their
+|    false literals, then the assumptions 'assumps' as unit clauses and the learnts of LBD at most
+|    'max_lbd' (none if negative). With 'full', the units of level 0 come first, so that the formula
+|    is equivalent to the one given (SimpSolver also writes its reconstruction stack).
+|________________________________________________________________________________________________@*/
+void Solver::writeDimacs(DimacsWriter& w, const vec<Lit>& assumps, int max_lbd, bool full) {
     // Handle case when solver is in contradictory state:
     if (!ok) {
-        fprintf(f, "p cnf 1 2\n1 0\n-1 0\n");
+        w.header(1, 2, false);
+        w.begin('a'); w.lit(mkLit(0)); w.end();
+        w.begin('a'); w.lit(~mkLit(0)); w.end();
         return;
     }
 
-    vec<Var> map;
-    Var max = 0;
+    // The header gives the largest variable written:
+    int units = full ? (decisionLevel() == 0 ? trail.size() : trail_lim[0]) : 0;
+    int cnt = units + assumps.size();
+    Var max = -1;
+    for (int i = 0; i < units; i++)
+        if (var(trail[i]) > max) max = var(trail[i]);
+    for (int i = 0; i < assumps.size(); i++)
+        if (var(assumps[i]) > max) max = var(assumps[i]);
+    for (int i = 0; i < clauses.size(); i++) {
+        const Clause& c = ca[clauses[i]];
+        if (satisfied(c)) continue;
+        cnt++;
+        for (int j = 0; j < c.size(); j++)
+            if (var(c[j]) > max && value(c[j]) != l_False) max = var(c[j]);
+    }
 
-    // Cannot use removeClauses here because it is not safe
-    // to deallocate them at this point. Could be improved.
-    int cnt = 0;
-    for (int i = 0; i < clauses.size(); i++)
-        if (!satisfied(ca[clauses[i]]))
-            cnt++;
+    // Cardinality constraints are written in the CNF+ format (see 'parse_DIMACS_main()'):
+    vec<int> cardBound(cards.size());
+    int ncards = 0;
+    for (int i = 0; i < cards.size(); i++) {
+        const Lit* lits = &cardLits[cards[i].start];
+        int nundef = 0;
+        cardBound[i] = cards[i].k;
+        for (int j = 0; j < cards[i].size; j++)
+            if (value(lits[j]) == l_True)
+                cardBound[i]--;
+            else if (value(lits[j]) == l_Undef)
+                nundef++;
+        if (cardBound[i] >= nundef)
+            cardBound[i] = -1; // satisfied
+        else {
+            ncards++;
+            for (int j = 0; j < cards[i].size; j++)
+                if (var(lits[j]) > max && value(lits[j]) == l_Undef) max = var(lits[j]);
+        }
+    }
+    cnt += ncards;
 
-    for (int i = 0; i < clauses.size(); i++)
-        if (!satisfied(ca[clauses[i]])) {
-            Clause& c = ca[clauses[i]];
+    vec<CRef> ls;
+    for (int i = 0; max_lbd >= 0 && i < learnts.size(); i++) {
+        const Clause& c = ca[learnts[i]];
+        if (!c.mark() && (int)ca.lbd(c) <= max_lbd && !satisfied(c)) {
+            ls.push(learnts[i]);
             for (int j = 0; j < c.size(); j++)
-                if (value(c[j]) != l_False)
-                    mapVar(var(c[j]), map, max);
+                if (var(c[j]) > max && value(c[j]) != l_False) max = var(c[j]);
         }
+    }
+    cnt += ls.size();
 
-    // Assumptions are added as unit clauses:
-    cnt += assumptions.size();
+    w.header(max + 1, cnt, ncards > 0);
 
-    fprintf(f, "p cnf %d %d\n", max, cnt);
+    if (units > 0) w.comment("units of level 0");
+    for (int i = 0; i < units; i++) {
+        w.begin('a'); w.lit(trail[i]); w.end();
+    }
 
-    for (int i = 0; i < assumptions.size(); i++) {
-        assert(value(assumptions[i]) != l_False);
-        fprintf(f, "%s%d 0\n", sign(assumptions[i]) ? "-" : "", mapVar(var(assumptions[i]), map, max) + 1);
+    for (int i = 0; i < assumps.size(); i++) {
+        w.begin('a'); w.lit(assumps[i]); w.end();
     }
 
-    for (int i = 0; i < clauses.size(); i++)
-        toDimacs(f, ca[clauses[i]], map, max);
+    for (int i = 0; i < clauses.size(); i++) {
+        const Clause& c = ca[clauses[i]];
+        if (satisfied(c)) continue;
+        w.begin('a');
+        for (int j = 0; j < c.size(); j++)
+            if (value(c[j]) != l_False)
+                w.lit(c[j]);
+        w.end();
+    }
+
+    for (int i = 0; i < cards.size(); i++) {
+        if (cardBound[i] < 0) continue;
+        const Lit* lits = &cardLits[cards[i].start];
+        w.begin('k');
+        for (int j = 0; j < cards[i].size; j++)
+            if (value(lits[j]) == l_Undef)
+                w.lit(lits[j]);
+        w.endAtMost(cardBound[i]);
+    }
+
+    if (ls.size() > 0) w.comment("learnts");
+    for (int i = 0; i < ls.size(); i++) {
+        const Clause& c = ca[ls[i]];
+        w.begin('l');
+        for (int j = 0; j < c.size(); j++)
+            if (value(c[j]) != l_False)
+                w.lit(c[j]);
+        w.endLearnt(ca.lbd(c));
+    }
 
     if (verbosity > 0)
-        printf("Wrote %d clauses with %d variables.\n", cnt, max);
+        printf("Wrote %d clauses with %d variables.\n", cnt, max + 1);
 }
 
 
@@ -1623,6 +3049,7 @@ void Solver::relocAll(ClauseAllocator& to) {
     // for (int i = 0; i < watches.size(); i++)
     watches.cleanAll();
     watchesBin.cleanAll();
+    watchesTer.cleanAll();
     unaryWatches.cleanAll();
     for (int v = 0; v < nVars(); v++)
         for (int s = 0; s < 2; s++) {
@@ -1634,6 +3061,9 @@ void Solver::relocAll(ClauseAllocator& to) {
             vec<Watcher>& ws2 = watchesBin[p];
             for (int j = 0; j < ws2.size(); j++)
                 ca.reloc(ws2[j].cref, to);
+            vec<TernaryWatcher>& ws4 = watchesTer[p];
+            for (int j = 0; j < ws4.size(); j++)
+                ca.reloc(ws4[j].cref, to);
             vec<Watcher>& ws3 = unaryWatches[p];
             for (int j = 0; j < ws3.size(); j++)
                 ca.reloc(ws3[j].cref, to);
@@ -1644,7 +3074,7 @@ void Solver::relocAll(ClauseAllocator& to) {
     for (int i = 0; i < trail.size(); i++) {
         Var v = var(trail[i]);
 
-        if (reason(v) != CRef_Undef && (ca[reason(v)].reloced() || locked(ca[reason(v)])))
+        if (reason(v) != CRef_Undef && !lazyReason(reason(v)) && (ca[reason(v)].reloced() || locked(ca[reason(v)])))
             ca.reloc(vardata[v].reason, to);
     }
 
@@ -1664,15 +3094,47 @@ void Solver::relocAll(ClauseAllocator& to) {
 
 
 
+void Solver::liveClauses(vec<CRef>& cs) {
+    // Reasons are kept under the same condition as in relocAll() (a removed binary clause may
+    // still be the reason of its second literal):
+    for (int i = 0; i < trail.size(); i++) {
+        CRef cr = reason(var(trail[i]));
+        if (cr != CRef_Undef && !lazyReason(cr) && locked(ca[cr]))
+            cs.push(cr);
+    }
+    for (int i = 0; i < learnts.size(); i++)
+        cs.push(learnts[i]);
+    for (int i = 0; i < clauses.size(); i++)
+        cs.push(clauses[i]);
+    for (int i = 0; i < unaryWatchedClauses.size(); i++)
+        cs.push(unaryWatchedClauses[i]);
+}
+
+
 void Solver::garbageCollect() {
+    TIME_PHASE(phaseTimers, phase_garbageCollect);
+    if (gc_inplace || mem_pressure > 0) {
+        ClauseAllocator::Size before = ca.size();
+        vec<CRef> cs;
+        liveClauses(cs);
+        ca.forward(cs);
+        relocAll(ca);
+        ca.compact(gc_release || mem_pressure > 0);
+        if (verbosity >= 2)
+            printf("|  Garbage collection:   %12" PRIu64 " bytes => %12" PRIu64 " bytes             |\n",
+                (uint64_t)before * ClauseAllocator::Unit_Size, (uint64_t)ca.size() * ClauseAllocator::Unit_Size);
+        return;
+    }
+
     // Initialize the next region to a size corresponding to the estimated utilization degree. This
     // is not precise but should avoid some unnecessary reallocations for the new region:
     ClauseAllocator to(ca.size() - ca.wasted());
 
+    to.clause_ids = ca.clause_ids;
     relocAll(to);
     if (verbosity >= 2)
-        printf("|  Garbage collection:   %12d bytes => %12d bytes             |\n",
-            ca.size() * ClauseAllocator::Unit_Size, to.size() * ClauseAllocator::Unit_Size);
+        printf("|  Garbage collection:   %12" PRIu64 " bytes => %12" PRIu64 " bytes             |\n",
+            (uint64_t)ca.size() * ClauseAllocator::Unit_Size, (uint64_t)to.size() * ClauseAllocator::Unit_Size);
     to.moveTo(ca);
 }
 
@@ -1683,7 +3145,7 @@ void Solver::garbageCollect() {
 //--------------------------------------------------------------
 
 bool Solver::panicModeIsEnabled() {
-    return false;
+    return mem_pressure > 0;
 }
 
 void Solver::parallelImportUnaryClauses() {
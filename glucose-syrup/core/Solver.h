@@ -56,6 +56,12 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include "core/SolverTypes.h"
 #include "core/BoundedQueue.h"
 #include "core/Constants.h"
+#include "core/DratWriter.h"
+#include "core/DimacsWriter.h"
+#include "core/VMTFQueue.h"
+#include "core/LocalSearch.h"
+#include "core/PhaseTimers.h"
+#include "core/ExternalPropagator.h"
 #include "mtl/Clone.h"
 
 
@@ -94,6 +100,13 @@ public:
     bool    addClause (Lit p, Lit q, Lit r);                    // Add a ternary clause to the solver. 
     virtual bool    addClause_(      vec<Lit>& ps);                     // Add a clause to the solver without making superflous internal copy. Will
                                                                 // change the passed vector 'ps'.
+    bool    addAtMost (const vec<Lit>& ps, int k);              // Add the constraint: at most 'k' literals of 'ps' are true (distinct variables).
+    virtual bool    addAtMost_(      vec<Lit>& ps, int k);      // 'addAtMost()' without the copy. Will change 'ps'.
+
+    // External propagator (see 'ExternalPropagator'):
+    //
+    void    connectPropagator(ExternalPropagator* p);           // NULL to disconnect. The propagator is not copied by 'clone()'.
+    virtual void observe  (Var v);                              // The propagator is notified of the assignments of 'v'.
 
     // Solving:
     //
@@ -106,10 +119,13 @@ public:
     bool    solve        (Lit p, Lit q, Lit r);     // Search for a model that respects three assumptions.
     bool    okay         () const;                  // FALSE means solver is in a conflicting state
 
+    // Write the formula (simplified at level 0) with 'assumps' as units, the learnts of LBD at most
+    // 'max_lbd' and, if 'full', the units of level 0 and the reconstruction stack (see DimacsWriter):
+    bool    toDimacs     (const char* file, const vec<Lit>& assumps, int max_lbd = -1, bool full = false, bool binary = false);
+    virtual void writeDimacs (DimacsWriter& w, const vec<Lit>& assumps, int max_lbd, bool full);
+
        // Convenience versions of 'toDimacs()':
     void    toDimacs     (FILE* f, const vec<Lit>& assumps);            // Write CNF to file in DIMACS-format.
-    void    toDimacs     (const char *file, const vec<Lit>& assumps);
-    void    toDimacs     (FILE* f, Clause& c, vec<Var>& map, Var& max);
     void    toDimacs     (const char* file);
     void    toDimacs     (const char* file, Lit p);
     void    toDimacs     (const char* file, Lit p, Lit q);
@@ -134,6 +150,8 @@ public:
     int     nAssigns   ()      const;       // The current number of assigned literals.
     int     nClauses   ()      const;       // The current number of original clauses.
     int     nLearnts   ()      const;       // The current number of learnt clauses.
+    int     nCards     ()      const;       // The current number of cardinality constraints.
+    int     nXors      ()      const;       // The current number of XOR constraints.
     int     nVars      ()      const;       // The current number of variables.
     int     assumptionsSize      ()      const;       // The current number of variables.
     int     nFreeVars  ()      const;
@@ -144,11 +162,14 @@ public:
     void setIncrementalMode();
     void initNbInitialVars(int nb);
     void printIncrementalStats();
+    void printStatsJSON(FILE* out, int call, lbool result); // One line of JSON with the statistics, after the given solve call.
     bool isIncremental();
     // Resource contraints:
     //
     void    setConfBudget(int64_t x);
     void    setPropBudget(int64_t x);
+    void    setTimeBudget(double seconds); // Wall-clock deadline, 'seconds' from now (preprocessing included).
+    void    setMemBudget (double mb);      // Resident memory the learnts are reduced to fit in, before giving up (0=none).
     void    budgetOff();
     void    interrupt();          // Trigger a (potentially asynchronous) interruption of the solver.
     void    clearInterrupt();     // Clear interrupt indicator flag.
@@ -194,16 +215,27 @@ public:
     double    random_var_freq;
     double    random_seed;
     int       ccmin_mode;         // Controls conflict clause minimization (0=none, 1=basic, 2=deep).
+    int       ccmin_budget;       // Literals visited to remove one literal, or to shrink one level, of a learnt clause (0=no limit).
+    int       shrink_mode;        // Shrinking of the levels of learnt clauses (0=none, 1=binary reasons, 2=all reasons, 3=and minimize).
     int       phase_saving;       // Controls the level of phase saving (0=none, 1=limited, 2=full).
     bool      rnd_pol;            // Use random polarities for branching heuristics.
     bool      rnd_init_act;       // Initialize variable activities with a small random value.
     
     // Constant for Memory managment
     double    garbage_frac;       // The fraction of wasted memory allowed before a garbage collection is triggered.
+    bool      gc_inplace;         // Compact the clause region in place instead of copying it to a new one.
+    bool      gc_release;         // Give the freed pages back to the system after an in place garbage collection.
 
     // Certified UNSAT ( Thanks to Marijn Heule)
     FILE*               certifiedOutput;
     bool                certifiedUNSAT;
+    bool                certifiedBinary;    // Binary DRAT instead of text.
+    bool                certifiedThread;    // Write the proof from a background thread.
+    bool                certifiedLRAT;      // LRAT proof (clause IDs and antecedents) instead of DRAT. No preprocessing, no incremental mode.
+    DratWriter*         certifiedProof;     // Buffered writer on certifiedOutput (see proof()).
+
+    DratWriter&         proof            ();                // The proof writer, created on first use.
+    void                closeProof       (bool unsat);      // Flush and close the proof (adding the empty clause if 'unsat').
 
     // Panic mode. 
     // Save memory
@@ -211,6 +243,20 @@ public:
     
     bool useUnaryWatched;            // Enable unary watched literals
     bool promoteOneWatchedClause;    // One watched clauses are promotted to two watched clauses if found empty
+    bool useTernaryWatches;          // Ternary clauses are watched on all their literals, other literals kept in the watcher
+    int  decisionQueue;              // 0=VSIDS heap, 1=VMTF, 2=switch between them every 'queueSwitchRestarts' restarts
+    int  queueSwitchRestarts;
+    bool stableSearch;               // Alternate the LBD restarts (focused mode) with a stable mode (see search())
+    int  stableRestarts;             // Restarts in stable mode: 0=Luby, 1=geometric
+    int  stableUnit;                 // Conflicts between two restarts in stable mode (unit of the sequence)
+    int  stableConflicts;            // Conflicts in the first mode (each mode then lasts 50% longer than the previous one)
+    int  rephaseInterval;            // Conflicts between two rephases (the interval grows arithmetically)
+    bool useLocalSearch;             // Initialize the saved phases with a local search (see localSearch())
+    int  lsFlips;                    // Budget of each local search
+    int  lsRestarts;                 // Restarts between two local searches (0=only before the search and at random rephases)
+    double lsCb;                     // Flip probability of a variable: (1+break)^-lsCb
+    bool useGauss;                   // Gauss-Jordan elimination on the XOR constraints found by the simplification (see propagateXors())
+    int  gaussMaxVars;               // No elimination if the XOR constraints have more variables than this
     
     // Functions useful for multithread solving
     // Useless in the sequential case 
@@ -232,14 +278,36 @@ public:
     //
     uint64_t nbRemovedClauses,nbRemovedUnaryWatchedClauses, nbReducedClauses,nbDL2,nbBin,nbUn,nbReduceDB,solves, starts, decisions, rnd_decisions, propagations, conflicts,conflictsRestarts,nbstopsrestarts,nbstopsrestartssame,lastblockatrestart;
     uint64_t dec_vars, clauses_literals, learnts_literals, max_literals, tot_literals;
+    uint64_t nbLocalSearches, lsFlipsTotal;
+    int      lsLastUnsat;        // Unsatisfied clauses at the end of the last local search
+    uint64_t nbCardPropagations, nbCardExplanations; // Literals implied by the cardinality constraints, and the clauses built to explain them
+    uint64_t nbGaussEliminations, nbXorPropagations, nbXorConflicts, nbXorExplanations; // Same for the XOR constraints
+    uint64_t nbExtPropagations, nbExtClauses, nbExtExplanations; // Same for the external propagator, and the clauses it added
+    PhaseTimers phaseTimers;     // Time spent in propagate, analyze... (only with PROFILE_PHASES)
 
 protected:
 
     long curRestart;
     // Helper structures:
     //
+#ifdef PACKED_VARDATA
+    // The fields read together by conflict analysis (and the value, read by propagation as well)
+    // share one record per variable, so one cache line:
+    struct VarData { CRef reason; int level; lbool value; char seen; };
+    static inline VarData mkVarData(CRef cr, int l){ VarData d = {cr, l, l_Undef, 0}; return d; }
+
+    // 'assigns' and 'seen' are then views of these records, indexed like a 'vec':
+    template<class T, T VarData::* field>
+    struct VarField {
+        vec<VarData>* records;
+        VarField() : records(NULL) {}
+        T&       operator [] (Var x)       { return (*records)[x].*field; }
+        const T& operator [] (Var x) const { return (*records)[x].*field; }
+    };
+#else
     struct VarData { CRef reason; int level; };
     static inline VarData mkVarData(CRef cr, int l){ VarData d = {cr, l}; return d; }
+#endif
 
     struct Watcher {
         CRef cref;
@@ -262,12 +330,48 @@ protected:
         bool operator()(const Watcher& w) const { return ca[w.cref].mark() == 1; }
     };
 
+    // Ternary clauses are watched on their three literals. The two other literals are stored
+    // inside the watcher, so propagation never has to look at the clause itself.
+    struct TernaryWatcher {
+        CRef cref;
+        Lit  other1, other2;
+        TernaryWatcher(CRef cr, Lit p, Lit q) : cref(cr), other1(p), other2(q) {}
+        bool operator==(const TernaryWatcher& w) const { return cref == w.cref; }
+        bool operator!=(const TernaryWatcher& w) const { return cref != w.cref; }
+    };
+
+    struct TernaryWatcherDeleted
+    {
+        const ClauseAllocator& ca;
+        TernaryWatcherDeleted(const ClauseAllocator& _ca) : ca(_ca) {}
+        bool operator()(const TernaryWatcher& w) const { return ca[w.cref].mark() == 1; }
+    };
+
+    // At most 'k' of the literals 'cardLits[start .. start+size-1]' are true, 'ntrue' of them
+    // were seen true by 'propagateCards()'. Cardinality constraints are never removed: their
+    // watches only refer to them by index.
+    struct CardConstraint { int k; int start; int size; int ntrue; };
+
+    struct CardWatcherDeleted
+    {
+        bool operator()(int) const { return false; }
+    };
+
     struct VarOrderLt {
         const vec<double>&  activity;
         bool operator () (Var x, Var y) const { return activity[x] > activity[y]; }
         VarOrderLt(const vec<double>&  act) : activity(act) { }
     };
 
+    struct LevelGt {
+        const vec<VarData>& vardata;
+        bool operator () (Lit x, Lit y) const { return vardata[var(x)].level > vardata[var(y)].level; }
+        LevelGt(const vec<VarData>& vd) : vardata(vd) { }
+    };
+
+    // A literal of 'litRedundant()' whose reason is searched from position 'i'.
+    struct ShrinkStackElem { uint32_t i; Lit l; ShrinkStackElem(uint32_t _i, Lit _l) : i(_i), l(_l) { } };
+
 
     // Solver state:
     //
@@ -280,13 +384,42 @@ protected:
                         watches;          // 'watches[lit]' is a list of constraints watching 'lit' (will go there if literal becomes true).
     OccLists<Lit, vec<Watcher>, WatcherDeleted>
                         watchesBin;          // 'watches[lit]' is a list of constraints watching 'lit' (will go there if literal becomes true).
+    OccLists<Lit, vec<TernaryWatcher>, TernaryWatcherDeleted>
+                        watchesTer;       // 'watchesTer[lit]' is the list of ternary clauses containing '~lit' (see useTernaryWatches)
     OccLists<Lit, vec<Watcher>, WatcherDeleted>
                         unaryWatches;       //  Unary watch scheme (clauses are seen when they become empty
     vec<CRef>           clauses;          // List of problem clauses.
     vec<CRef>           learnts;          // List of learnt clauses.
     vec<CRef>           unaryWatchedClauses;  // List of imported clauses (after the purgatory) // TODO put inside ParallelSolver
-
+    vec<CardConstraint> cards;            // List of cardinality constraints.
+    vec<Lit>            cardLits;         // Literals of the cardinality constraints.
+    OccLists<Lit, vec<int>, CardWatcherDeleted>
+                        watchesCard;      // 'watchesCard[lit]' is the list of cardinality constraints containing 'lit' (seen when it becomes true).
+    vec<int>            cardReason;       // 'cardReason[var]': the constraint that implied 'var', when its reason is 'CRef_Card'.
+    int                 cardTrailHead;    // Position in the trail up to which the assignments are counted in the 'ntrue' of the constraints.
+    vec<Var>            xorVars;          // Variables of the XOR constraints, each one followed by 'var_Undef'.
+    vec<char>           xorRhs;           // Parity of each XOR constraint.
+    vec<int>            xorVarCol;        // 'xorVarCol[var]': column of 'var' in the matrix of the XOR constraints, -1 if none.
+    vec<Var>            xorColVar;        // Variable of each column.
+    int                 xorWords;         // Number of 64 bits words of a row.
+    vec<uint64_t>       xorMatrix;        // One row per XOR constraint, one bit per column (empty until 'buildXorMatrix()').
+    vec<uint64_t>       xorRows;          // The matrix kept eliminated by 'propagateXors()' across calls, its parities, and the
+    vec<char>           xorRowsRhs;       // pivot of each row (a column only in this row, -1 if none).
+    vec<int>            xorPivot;
+    vec<uint64_t>       xorAssigned;      // Columns assigned, and assigned true, for 'propagateXors()'.
+    vec<uint64_t>       xorTrue;
+    vec<uint64_t>       xorReason;        // Row 'col' is the combination of rows that implied the variable of 'col', when its reason is 'CRef_Xor'.
+    int                 xorTrailHead;     // Position in the trail up to which the assignments were seen by 'propagateXors()' (-1: none).
+    ExternalPropagator* propagator;       // The external propagator, if any (see 'propagateExternal()').
+    vec<char>           observed;         // 'observed[var]' is true if the propagator is notified of the assignments of 'var'.
+    int                 extTrailHead;     // Position in the trail up to which the propagator was notified.
+
+#ifdef PACKED_VARDATA
+    VarField<lbool, &VarData::value>
+                        assigns;          // The current assignments (in 'vardata').
+#else
     vec<lbool>          assigns;          // The current assignments.
+#endif
     vec<char>           polarity;         // The preferred polarity of each variable.
     vec<char>           decision;         // Declares if a variable is eligible for selection in the decision heuristic.
     vec<Lit>            trail;            // Assignment stack; stores all assigments made in the order they were made.
@@ -298,6 +431,8 @@ protected:
     int64_t             simpDB_props;     // Remaining number of propagations that must be made before next execution of 'simplify()'.
     vec<Lit>            assumptions;      // Current set of assumptions provided to solve by the user.
     Heap<VarOrderLt>    order_heap;       // A priority queue of variables ordered with respect to the variable activity.
+    VMTFQueue           vmtf_queue;       // Variables in the order of their last bump (see decisionQueue).
+    bool                useVMTF;          // 'vmtf_queue' is the current decision queue, instead of 'order_heap'.
     double              progress_estimate;// Set by 'search()'.
     bool                remove_satisfied; // Indicates whether possibly inefficient linear scan for satisfied clauses should be performed in 'simplify'.
     bool reduceOnSize;
@@ -322,12 +457,33 @@ protected:
     // Temporaries (to reduce allocation overhead). Each variable is prefixed by the method in which it is
     // used, exept 'seen' wich is used in several places.
     //
+    // Marks of 'seen' while a learnt clause is simplified: in the clause (as learnt), implied by the
+    // clause, not known to be implied, and level being shrunk.
+    enum { seen_undef = 0, seen_source = 1, seen_removable = 2, seen_failed = 3, seen_shrink = 4 };
+#ifdef PACKED_VARDATA
+    VarField<char, &VarData::seen>
+                        seen;             // (in 'vardata')
+#else
     vec<char>           seen;
+#endif
     vec<Lit>            analyze_stack;
     vec<Lit>            analyze_toclear;
+    vec<ShrinkStackElem> minimize_stack;
+    vec<Lit>            shrink_pulled;
     vec<Lit>            add_tmp;
     unsigned int  MYFLAG;
 
+    // LRAT proofs: input clauses are numbered from 1 in the order they are given, then each derived
+    // clause takes the next ID. IDs live in the clauses (see ClauseAllocator::id()), except for
+    // the units of level 0 which are not stored as clauses.
+    uint64_t            lratLastId;         // Last ID given.
+    vec<uint64_t>       lratUnit;           // lratUnit[var] is the ID of the unit clause of a variable assigned at level 0 (0 if not derived yet).
+    int                 lratUnitsDone;      // The units of the level 0 trail are derived up to here.
+    vec<uint64_t>       lratChain;          // Antecedents of the last learnt clause, in propagation order.
+    vec<CRef>           lratMinimized;      // Binary clauses used by 'minimisationWithBinaryResolution()'.
+    vec<Lit>            lratConflict;       // A clause falsified at level 0 (for the empty clause)...
+    uint64_t            lratConflictId;     // ... and its ID.
+
     // Initial reduceDB strategy
     double              max_learnts;
     double              learntsize_adjust_confl;
@@ -337,6 +493,13 @@ protected:
     //
     int64_t             conflict_budget;    // -1 means no budget.
     int64_t             propagation_budget; // -1 means no budget.
+    double              deadline;           // Wall-clock time (see realTime()), 0 means no deadline.
+    mutable int         deadline_countdown; // Budget checks before the next reading of the clock...
+    mutable int         deadline_interval;  // ... calibrated to read it about every 10ms.
+    mutable double      deadline_checked;   // Time of the last reading.
+    double              mem_budget;         // Resident memory in megabytes (see checkMemory()), 0 means no budget.
+    int                 mem_pressure;       // 0 below 75% of the budget, 1 below 90%, 2 above, 3 when giving up.
+    uint64_t            mem_next_check;     // Conflicts at the next reading of the memory used.
     bool                asynch_interrupt;
 
     // Variables added for incremental mode
@@ -346,6 +509,21 @@ protected:
     int nbSatCalls,nbUnsatCalls;
     vec<int> assumptionPositions,initialPositions;
 
+    // Stable mode: restarts follow a Luby or geometric sequence and decisions follow the target
+    // phases, i.e. the longest conflict-free assignment since the last rephase or mode switch. The
+    // best phases are the longest ones since the last rephase to them. Rephasing (in both modes)
+    // cycles through the best, original, inverted and random phases.
+    bool                stableMode;
+    int                 modeRestarts;     // Restarts since the last mode switch (index in the restart sequence)
+    uint64_t            nextModeSwitch;
+    double              modeConflicts;    // Length of the current mode
+    uint64_t            nextRephase;
+    int                 nbRephases;
+    vec<char>           targetPolarity;   // Same as 'polarity', 2 if not set
+    vec<char>           bestPolarity;
+    int                 targetAssigned;
+    int                 bestAssigned;
+
 
     // Main internal methods:
     //
@@ -355,16 +533,47 @@ protected:
     void     uncheckedEnqueue (Lit p, CRef from = CRef_Undef);                         // Enqueue a literal. Assumes value of literal is undefined.
     bool     enqueue          (Lit p, CRef from = CRef_Undef);                         // Test if fact 'p' contradicts current state, enqueue otherwise.
     CRef     propagate        ();                                                      // Perform unit propagation. Returns possibly conflicting clause.
+    template<bool Incremental, bool UnaryWatched>
+    CRef     propagate_       ();                                                      // 'propagate()' for the mode of the solver.
     CRef     propagateUnaryWatches(Lit p);                                                  // Perform propagation on unary watches of p, can find only conflicts
+    CRef     propagateCards   (Lit p);                                                 // Propagate the cardinality constraints containing 'p' (true). Returns possibly conflicting clause.
+    CRef     addExplanation   (vec<Lit>& ps);                                          // Add a clause implied by a cardinality or XOR constraint (as a learnt).
+    bool     addXor           (const vec<Var>& vs, bool rhs);                          // Add the constraint: the sum of 'vs' modulo 2 is 'rhs' (also implied by the clauses).
+    void     buildXorMatrix   ();                                                      // Build the matrix of the XOR constraints added since the last call.
+    CRef     propagateXors    ();                                                      // Gauss-Jordan elimination on the XOR constraints. Returns possibly conflicting clause.
+    CRef     propagateExternal();                                                      // Clauses and literals from the external propagator. Returns possibly conflicting clause.
+    CRef     addExternalClause(vec<Lit>& ps, bool learnt);                             // Add a clause from the external propagator during the search (see 'propagateExternal()').
+    CRef     explain          (Var x);                                                 // Reason of 'x' as a clause: builds it if 'x' was implied by a cardinality or XOR constraint, or by the external propagator.
+    CRef     explainCard      (Var x);                                                 // (helper methods for 'explain()')
+    CRef     explainXor       (Var x);
+    CRef     explainExternal  (Var x);
+    static bool lazyReason    (CRef cr);                                               // Reason explained on demand, not a clause yet.
     void     cancelUntil      (int level);                                             // Backtrack until a certain level.
     void     analyze          (CRef confl, vec<Lit>& out_learnt, vec<Lit> & selectors, int& out_btlevel,unsigned int &nblevels,unsigned int &szWithoutSelectors);    // (bt = backtrack)
+    template<bool Incremental>
+    void     analyze_         (CRef confl, vec<Lit>& out_learnt, vec<Lit> & selectors, int& out_btlevel,unsigned int &nblevels,unsigned int &szWithoutSelectors);    // 'analyze()' for the mode of the solver.
     void     analyzeFinal     (Lit p, vec<Lit>& out_conflict);                         // COULD THIS BE IMPLEMENTED BY THE ORDINARIY "analyze" BY SOME REASONABLE GENERALIZATION?
     bool     litRedundant     (Lit p, uint32_t abstract_levels);                       // (helper method for 'analyze()')
+    void     shrinkLearnt     (vec<Lit>& out_learnt, uint32_t abstract_levels);        // Replace the literals of each level by a dominator (helper method for 'analyze()').
+    Lit      shrinkLevel      (const vec<Lit>& out_learnt, int begin, int end, uint32_t abstract_levels); // (helper method for 'shrinkLearnt()')
+    void     lratAntecedents  (CRef confl, const vec<Lit>& out_learnt);               // Fill 'lratChain' for the learnt clause (helper method for 'analyze()').
+    void     lratVisit        (Lit q);                                                 // (helper method for 'lratAntecedents()')
+    void     lratDeriveUnits  ();                                                      // Give an ID to each unit of level 0.
+    void     lratRootConflict (CRef confl);                                            // Remember a clause falsified at level 0.
+    void     lratEmptyClause  ();                                                      // Add the empty clause to the LRAT proof.
+    bool     addClauseLRAT_   (vec<Lit>& ps);                                          // 'addClause_()' when clauses have IDs.
     lbool    search           (int nof_conflicts);                                     // Search for a given number of conflicts.
     virtual lbool    solve_           (bool do_simp = true, bool turn_off_simp = false);                                                      // Main solve method (assumptions given in 'assumptions').
     virtual void     reduceDB         ();                                                      // Reduce the set of learnt clauses.
     void     removeSatisfied  (vec<CRef>& cs);                                         // Shrink 'cs' to contain only non-satisfied clauses.
     void     rebuildOrderHeap ();
+    void     switchDecisionQueue();                                                    // Use the other decision queue (at restarts).
+    bool     decisionPolarity (Var v) const;                                           // Saved phase, or target phase in stable mode.
+    int      stableRestartLimit();                                                     // Conflicts before the next restart in stable mode.
+    void     updateTargetPhases();                                                     // Save the conflict-free part of the trail as target (and best) phases.
+    void     rephase          ();                                                      // Reset the saved phases.
+    void     updateSearchMode ();                                                      // Rephase and switch between focused and stable mode (at restarts).
+    void     localSearch      ();                                                      // Set the saved phases with a local search.
 
     // Maintaining Variable/Clause activity:
     //
@@ -382,13 +591,19 @@ protected:
     void     attachClausePurgatory(CRef cr);
     void     removeClause     (CRef cr, bool inPurgatory = false);               // Detach and free a clause.
     bool     locked           (const Clause& c) const; // Returns TRUE if a clause is a reason for some implication in the current state.
+    int      lockedLit        (const Clause& c) const; // Index of the literal 'c' is the reason of, or -1 if it is not locked.
     bool     satisfied        (const Clause& c) const; // Returns TRUE if a clause is satisfied in the current state.
+    bool     isTernaryWatched (const Clause& c) const; // Returns TRUE if the clause lives in the ternary watch lists.
+    void     reasonFirst      (Clause& c, Var v);      // Move the literal of 'v' in front of its (binary or ternary) reason clause.
 
     unsigned int computeLBD(const vec<Lit> & lits,int end=-1);
     unsigned int computeLBD(const Clause &c);
+    template<bool Incremental> unsigned int computeLBD_(const vec<Lit> & lits,int end=-1);
+    template<bool Incremental> unsigned int computeLBD_(const Clause &c);
     void minimisationWithBinaryResolution(vec<Lit> &out_learnt);
 
     virtual void     relocAll         (ClauseAllocator& to);
+    virtual void     liveClauses      (vec<CRef>& cs);         // Every clause that may be referenced (for in place garbage collection).
 
     // Misc:
     //
@@ -398,7 +613,12 @@ protected:
     int      level            (Var x) const;
     double   progressEstimate ()      const; // DELETE THIS ?? IT'S NOT VERY USEFUL ...
     bool     withinBudget     ()      const;
+    bool     withinDeadline   ()      const;
+    void     checkMemory      ();                      // Adapt the reductions of the learnts to the memory used.
+    bool     interrupted      ()      const; // Interrupted, or past the deadline (checked by preprocessing).
     inline bool isSelector(Var v) {return (incremental && v>nbVarsInitialFormula);}
+    template<bool Incremental>
+    inline bool isSelector_(Var v) const {return (Incremental && v>nbVarsInitialFormula);}
 
     // Static helpers:
     //
@@ -422,12 +642,21 @@ protected:
 inline CRef Solver::reason(Var x) const { return vardata[x].reason; }
 inline int  Solver::level (Var x) const { return vardata[x].level; }
 
+// The decision queue is either 'order_heap' (VSIDS) or 'vmtf_queue', depending on 'useVMTF'. Both
+// are only accessed through insertVarOrder(), varBumpActivity(), pickBranchLit() and rebuildOrderHeap().
+// VMTF bumps are applied together at the end of 'analyze()'.
+
 inline void Solver::insertVarOrder(Var x) {
-    if (!order_heap.inHeap(x) && decision[x]) order_heap.insert(x); }
+    if (useVMTF) vmtf_queue.unassign(x);
+    else if (!order_heap.inHeap(x) && decision[x]) order_heap.insert(x); }
+
+inline bool Solver::decisionPolarity(Var v) const {
+    return stableMode && targetPolarity[v] != 2 ? targetPolarity[v] : polarity[v]; }
 
-inline void Solver::varDecayActivity() { var_inc *= (1 / var_decay); }
+inline void Solver::varDecayActivity() { if (!useVMTF) var_inc *= (1 / var_decay); }
 inline void Solver::varBumpActivity(Var v) { varBumpActivity(v, var_inc); }
 inline void Solver::varBumpActivity(Var v, double inc) {
+    if (useVMTF) { vmtf_queue.bump(v); return; }
     if ( (activity[v] += inc) > 1e100 ) {
         // Rescale:
         for (int i = 0; i < nVars(); i++)
@@ -440,13 +669,13 @@ inline void Solver::varBumpActivity(Var v, double inc) {
 
 inline void Solver::claDecayActivity() { cla_inc *= (1 / clause_decay); }
 inline void Solver::claBumpActivity (Clause& c) {
-        if ( (c.activity() += cla_inc) > 1e20 ) {
+        if ( (ca.activity(c) += cla_inc) > 1e20 ) {
             // Rescale:
             for (int i = 0; i < learnts.size(); i++)
-                ca[learnts[i]].activity() *= 1e-20;
+                ca.activity(ca[learnts[i]]) *= 1e-20;
             cla_inc *= 1e-20; } }
 
-inline void Solver::checkGarbage(void){ return checkGarbage(garbage_frac); }
+inline void Solver::checkGarbage(void){ return checkGarbage(mem_pressure > 0 ? garbage_frac / 4 : garbage_frac); }
 inline void Solver::checkGarbage(double gf){
     if (ca.wasted() > ca.size() * gf)
         garbageCollect(); }
@@ -458,14 +687,27 @@ inline bool     Solver::addEmptyClause  ()                      { add_tmp.clear(
 inline bool     Solver::addClause       (Lit p)                 { add_tmp.clear(); add_tmp.push(p); return addClause_(add_tmp); }
 inline bool     Solver::addClause       (Lit p, Lit q)          { add_tmp.clear(); add_tmp.push(p); add_tmp.push(q); return addClause_(add_tmp); }
 inline bool     Solver::addClause       (Lit p, Lit q, Lit r)   { add_tmp.clear(); add_tmp.push(p); add_tmp.push(q); add_tmp.push(r); return addClause_(add_tmp); }
- inline bool     Solver::locked          (const Clause& c) const { 
-   if(c.size()>2) 
-     return value(c[0]) == l_True && reason(var(c[0])) != CRef_Undef && ca.lea(reason(var(c[0]))) == &c; 
-   return 
-     (value(c[0]) == l_True && reason(var(c[0])) != CRef_Undef && ca.lea(reason(var(c[0]))) == &c)
-     || 
-     (value(c[1]) == l_True && reason(var(c[1])) != CRef_Undef && ca.lea(reason(var(c[1]))) == &c);
+inline bool     Solver::addAtMost       (const vec<Lit>& ps, int k) { ps.copyTo(add_tmp); return addAtMost_(add_tmp, k); }
+inline CRef     Solver::explain         (Var x)                 {
+    CRef cr = reason(x);
+    return cr == CRef_Card ? explainCard(x) : cr == CRef_Xor ? explainXor(x) : cr == CRef_Ext ? explainExternal(x) : cr; }
+inline bool     Solver::lazyReason      (CRef cr)               { return cr == CRef_Card || cr == CRef_Xor || cr == CRef_Ext; }
+ inline bool     Solver::locked          (const Clause& c) const { return lockedLit(c) >= 0; }
+ inline int      Solver::lockedLit       (const Clause& c) const { 
+   if(c.size()>2 && !isTernaryWatched(c)) 
+     return value(c[0]) == l_True && reason(var(c[0])) != CRef_Undef && !lazyReason(reason(var(c[0]))) && ca.lea(reason(var(c[0]))) == &c ? 0 : -1; 
+   // Binary and ternary clauses do not keep the propagated literal in front
+   for (int i = 0; i < c.size(); i++)
+     if (value(c[i]) == l_True && reason(var(c[i])) != CRef_Undef && !lazyReason(reason(var(c[i]))) && ca.lea(reason(var(c[i]))) == &c)
+       return i;
+   return -1;
  }
+inline bool     Solver::isTernaryWatched(const Clause& c) const { return useTernaryWatches && c.size() == 3; }
+inline void     Solver::reasonFirst   (Clause& c, Var v) {
+    if (c.size() > 3 || var(c[0]) == v) return;
+    int k = var(c[1]) == v ? 1 : 2;
+    assert(var(c[k]) == v);
+    Lit tmp = c[0]; c[0] = c[k], c[k] = tmp; }
 inline void     Solver::newDecisionLevel()                      { trail_lim.push(trail.size()); }
 
 inline int      Solver::decisionLevel ()      const   { return trail_lim.size(); }
@@ -477,6 +719,8 @@ inline lbool    Solver::modelValue    (Lit p) const   { return model[var(p)] ^ s
 inline int      Solver::nAssigns      ()      const   { return trail.size(); }
 inline int      Solver::nClauses      ()      const   { return clauses.size(); }
 inline int      Solver::nLearnts      ()      const   { return learnts.size(); }
+inline int      Solver::nCards        ()      const   { return cards.size(); }
+inline int      Solver::nXors         ()      const   { return xorRhs.size(); }
 inline int      Solver::nVars         ()      const   { return vardata.size(); }
 inline int      Solver::assumptionsSize         ()      const   { return assumptions.size(); }
 inline int      Solver::nFreeVars     ()      const   { return (int)dec_vars - (trail_lim.size() == 0 ? trail.size() : trail_lim[0]); }
@@ -493,11 +737,14 @@ inline void     Solver::setConfBudget(int64_t x){ conflict_budget    = conflicts
 inline void     Solver::setPropBudget(int64_t x){ propagation_budget = propagations + x; }
 inline void     Solver::interrupt(){ asynch_interrupt = true; }
 inline void     Solver::clearInterrupt(){ asynch_interrupt = false; }
-inline void     Solver::budgetOff(){ conflict_budget = propagation_budget = -1; }
+inline void     Solver::budgetOff(){ conflict_budget = propagation_budget = -1; deadline = 0; }
 inline bool     Solver::withinBudget() const {
-    return !asynch_interrupt &&
+    return !asynch_interrupt && mem_pressure < 3 &&
            (conflict_budget    < 0 || conflicts < (uint64_t)conflict_budget) &&
-           (propagation_budget < 0 || propagations < (uint64_t)propagation_budget); }
+           (propagation_budget < 0 || propagations < (uint64_t)propagation_budget) &&
+           (deadline == 0 || --deadline_countdown > 0 || withinDeadline()); }
+inline bool     Solver::interrupted() const {
+    return asynch_interrupt || (deadline != 0 && --deadline_countdown <= 0 && !withinDeadline()); }
 
 // FIXME: after the introduction of asynchronous interrruptions the solve-versions that return a
 // pure bool do not give a safe interface. Either interrupts must be possible to turn off here, or
@@ -564,12 +811,12 @@ struct reduceDB_lt {
         if (ca[x].size() == 2 && ca[y].size() == 2) return 0;
 
         // Second one  based on literal block distance
-        if (ca[x].lbd() > ca[y].lbd()) return 1;
-        if (ca[x].lbd() < ca[y].lbd()) return 0;
+        if (ca.lbd(ca[x]) > ca.lbd(ca[y])) return 1;
+        if (ca.lbd(ca[x]) < ca.lbd(ca[y])) return 0;
 
 
         // Finally we can use old activity or size, we choose the last one
-        return ca[x].activity() < ca[y].activity();
+        return ca.activity(ca[x]) < ca.activity(ca[y]);
         //return x->size() < y->size();
 
         //return ca[x].size() > 2 && (ca[y].size() == 2 || ca[x].activity() < ca[y].activity()); } 
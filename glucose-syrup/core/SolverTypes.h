@@ -60,6 +60,8 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include "mtl/Vec.h"
 #include "mtl/Map.h"
 #include "mtl/Alloc.h"
+#include "mtl/Sort.h"
+#include "core/Constants.h"
 
 
 namespace Glucose {
@@ -193,7 +195,7 @@ class Clause {
 	
         if (header.extra_size > 0){
 	  if (header.learnt) 
-                data[header.size].act = 0; 
+                data[header.size].act = 0; // (or the learnt ID, see ClauseAllocator)
             else 
                 calcAbstraction();
 	  if (header.extra_size > 1) {
@@ -236,7 +238,13 @@ public:
     Lit          operator [] (int i) const   { return data[i].lit; }
     operator const Lit* (void) const         { return (Lit*)data; }
 
+#ifndef LEARNTS_METADATA_TABLE
     float&       activity    ()              { assert(header.extra_size > 0); return data[header.size].act; }
+#else
+    // The activity and the other learnt metadata are kept by the ClauseAllocator (see below)
+    uint32_t     learntId    () const        { assert(header.learnt && header.extra_size > 0); return data[header.size].abs; }
+    void         setLearntId (uint32_t id)   { assert(header.learnt && header.extra_size > 0); data[header.size].abs = id; }
+#endif
     uint32_t     abstraction () const        { assert(header.extra_size > 0); return data[header.size].abs; }
 
     // Handle imported clauses lazy sharing
@@ -246,15 +254,17 @@ public:
 
     Lit          subsumes    (const Clause& other) const;
     void         strengthen  (Lit p);
+#ifndef LEARNTS_METADATA_TABLE
     void         setLBD(int i)  {if (i < (1<<(BITS_LBD-1))) header.lbd = i; else header.lbd = (1<<(BITS_LBD-1));} 
     // unsigned int&       lbd    ()              { return header.lbd; }
     unsigned int        lbd    () const        { return header.lbd; }
     void setCanBeDel(bool b) {header.canbedel = b;}
-    bool canBeDel() {return header.canbedel;}
+    bool canBeDel() const {return header.canbedel;}
+    void setExported(unsigned int b) {header.exported = b;}
+    unsigned int getExported() const {return header.exported;}
+#endif
     void setSeen(bool b) {header.seen = b;}
     bool getSeen() {return header.seen;}
-    void setExported(unsigned int b) {header.exported = b;}
-    unsigned int getExported() {return header.exported;}
     void setOneWatched(bool b) {header.oneWatched = b;}
     bool getOneWatched() {return header.oneWatched;}
     void setSizeWithoutSelectors   (unsigned int n)              {header.szWithoutSelectors = n; }
@@ -265,23 +275,98 @@ public:
 
 //=================================================================================================
 // ClauseAllocator -- a simple class for allocating memory for clauses:
+//
+// The metadata of learnt clauses (activity, LBD, deletion and export flags) is accessed through
+// the allocator. By default it lives in the clause itself. With LEARNTS_METADATA_TABLE it is moved
+// to a dense side table indexed by a learnt ID (stored after the literals, in place of the
+// activity): propagation only brings literals in cache and reduceDB sorts the table without
+// touching the clauses.
+//
+// With 'clause_ids' (LRAT proofs), every clause has a 64 bits ID, stored after the extra fields.
+// The ID is not moved when a clause is shrunk: such clauses are not strengthened.
 
 
 const CRef CRef_Undef = RegionAllocator<uint32_t>::Ref_Undef;
+const CRef CRef_Card  = CRef_Undef - 1; // Reason of a literal implied by a cardinality constraint (explained on demand).
+const CRef CRef_Xor   = CRef_Undef - 2; // Reason of a literal implied by the XOR constraints (explained on demand).
+const CRef CRef_Ext   = CRef_Undef - 3; // Reason of a literal implied by the external propagator (explained on demand).
+// The allocator never gives out these references (see 'Ref_Reserved'): no clause can be taken for a lazy reason.
 class ClauseAllocator : public RegionAllocator<uint32_t>
 {
     static int clauseWord32Size(int size, int extra_size){
         return (sizeof(Clause) + (sizeof(Lit) * (size + extra_size))) / sizeof(uint32_t); }
+
+#ifdef LEARNTS_METADATA_TABLE
+    struct LearntMeta {
+        CRef     cref;          // The clause owning this entry (CRef_Undef if the entry is free)
+        float    act;
+        unsigned lbd      : BITS_LBD;
+        unsigned canbedel : 1;
+        unsigned exported : 2;
+        unsigned binary   : 1;   // (learnt clauses are never shrunk)
+        unsigned imported : 1;
+    };
+
+    // Same order as reduceDB_lt (see Solver.h), computed on the table only
+    struct LearntMetaLt {
+        const vec<LearntMeta>& meta;
+        LearntMetaLt(const vec<LearntMeta>& m) : meta(m) {}
+        bool operator () (uint32_t x, uint32_t y) const {
+            if (meta[x].binary != meta[y].binary) return meta[y].binary;
+            if (meta[x].lbd != meta[y].lbd) return meta[x].lbd > meta[y].lbd;
+            return meta[x].act < meta[y].act; }
+    };
+
+    vec<LearntMeta> learnts_meta;
+    vec<uint32_t>   free_ids;
+
+    LearntMeta&       meta(const Clause& c)       { return learnts_meta[c.learntId()]; }
+    const LearntMeta& meta(const Clause& c) const { return learnts_meta[c.learntId()]; }
+
+    uint32_t newLearntId(CRef cr, bool binary, bool imported) {
+        uint32_t id;
+        if (free_ids.size() > 0) { id = free_ids.last(); free_ids.pop(); }
+        else                     { id = learnts_meta.size(); learnts_meta.push(); }
+        LearntMeta& m = learnts_meta[id];
+        m.cref = cr; m.act = 0; m.lbd = 0; m.canbedel = 1; m.exported = 0;
+        m.binary = binary; m.imported = imported;
+        return id; }
+#endif
+
+    vec<CRef> fwd_refs;     // Clauses being compacted in place, by increasing address (see forward())
+    vec<Lit>  fwd_lits;     // Their first literal, overwritten by the forwarding reference
+
+    int clauseWords(const Clause& c, int extra_size) const {
+        return clauseWord32Size(c.size(), extra_size) + (clause_ids ? 2 : 0); }
+
+    uint32_t* idWords(const Clause& c) const {
+        return (uint32_t*)&c.data[c.size() + c.header.extra_size]; }
+
  public:
     bool extra_clause_field;
+    bool clause_ids;
 
-    ClauseAllocator(uint32_t start_cap) : RegionAllocator<uint32_t>(start_cap), extra_clause_field(false){}
-    ClauseAllocator() : extra_clause_field(false){}
+    ClauseAllocator(Size start_cap) : RegionAllocator<uint32_t>(start_cap), extra_clause_field(false), clause_ids(false){}
+    ClauseAllocator() : extra_clause_field(false), clause_ids(false){}
 
     void moveTo(ClauseAllocator& to){
         to.extra_clause_field = extra_clause_field;
+        to.clause_ids = clause_ids;
+#ifdef LEARNTS_METADATA_TABLE
+        learnts_meta.moveTo(to.learnts_meta);
+        free_ids.moveTo(to.free_ids);
+#endif
         RegionAllocator<uint32_t>::moveTo(to); }
 
+    void copyTo(ClauseAllocator& to) const {
+        to.extra_clause_field = extra_clause_field;
+        to.clause_ids = clause_ids;
+#ifdef LEARNTS_METADATA_TABLE
+        learnts_meta.copyTo(to.learnts_meta);
+        free_ids.copyTo(to.free_ids);
+#endif
+        RegionAllocator<uint32_t>::copyTo(to); }
+
     template<class Lits>
     CRef alloc(const Lits& ps, bool learnt = false, bool imported = false)
     {
@@ -290,8 +375,14 @@ class ClauseAllocator : public RegionAllocator<uint32_t>
 	
         bool use_extra = learnt | extra_clause_field;
         int extra_size = imported?3:(use_extra?1:0);
-        CRef cid = RegionAllocator<uint32_t>::alloc(clauseWord32Size(ps.size(), extra_size));
+        CRef cid = RegionAllocator<uint32_t>::alloc(clauseWord32Size(ps.size(), extra_size) + (clause_ids ? 2 : 0));
         new (lea(cid)) Clause(ps, extra_size, learnt);
+        if (clause_ids)
+            setId(operator[](cid), 0);
+#ifdef LEARNTS_METADATA_TABLE
+        if (learnt)
+            lea(cid)->setLearntId(newLearntId(cid, ps.size() == 2, imported));
+#endif
 
         return cid;
     }
@@ -306,14 +397,56 @@ class ClauseAllocator : public RegionAllocator<uint32_t>
     void free(CRef cid)
     {
         Clause& c = operator[](cid);
-        RegionAllocator<uint32_t>::free(clauseWord32Size(c.size(), c.has_extra()));
+#ifdef LEARNTS_METADATA_TABLE
+        if (c.learnt()) {
+            meta(c).cref = CRef_Undef;
+            free_ids.push(c.learntId());
+        }
+#endif
+        RegionAllocator<uint32_t>::free(clauseWords(c, c.has_extra()));
     }
 
+    // Clause IDs (LRAT proofs):
+    uint64_t     id          (const Clause& c) const     { assert(clause_ids); uint32_t* w = idWords(c); return w[0] | ((uint64_t)w[1] << 32); }
+    void         setId       (Clause& c, uint64_t id)    { assert(clause_ids); uint32_t* w = idWords(c); w[0] = (uint32_t)id; w[1] = (uint32_t)(id >> 32); }
+
+    // Learnt clauses metadata:
+#ifndef LEARNTS_METADATA_TABLE
+    float&       activity    (Clause& c)                 { return c.activity(); }
+    unsigned int lbd         (const Clause& c) const     { return c.lbd(); }
+    void         setLBD      (Clause& c, int i)          { c.setLBD(i); }
+    bool         canBeDel    (const Clause& c) const     { return c.canBeDel(); }
+    void         setCanBeDel (Clause& c, bool b)         { c.setCanBeDel(b); }
+    unsigned int getExported (const Clause& c) const     { return c.getExported(); }
+    void         setExported (Clause& c, unsigned int b) { c.setExported(b); }
+#else
+    float&       activity    (Clause& c)                 { return meta(c).act; }
+    unsigned int lbd         (const Clause& c) const     { return c.learnt() ? meta(c).lbd : 0; }
+    void         setLBD      (Clause& c, int i)          { meta(c).lbd = i < (1<<(BITS_LBD-1)) ? i : (1<<(BITS_LBD-1)); }
+    bool         canBeDel    (const Clause& c) const     { return meta(c).canbedel; }
+    void         setCanBeDel (Clause& c, bool b)         { meta(c).canbedel = b; }
+    unsigned int getExported (const Clause& c) const     { return meta(c).exported; }
+    void         setExported (Clause& c, unsigned int b) { meta(c).exported = b; }
+
+    // Refill 'cs' with the live learnt clauses (imported ones or not) in reduceDB order, by
+    // sorting the metadata table:
+    void sortLearnts(vec<CRef>& cs, bool imported) {
+        vec<uint32_t> ids;
+        for (int i = 0; i < learnts_meta.size(); i++)
+            if (learnts_meta[i].cref != CRef_Undef && learnts_meta[i].imported == imported)
+                ids.push(i);
+        sort(ids, LearntMetaLt(learnts_meta));
+        assert(ids.size() == cs.size());
+        for (int i = 0; i < ids.size(); i++)
+            cs[i] = learnts_meta[ids[i]].cref; }
+#endif
+
     void reloc(CRef& cr, ClauseAllocator& to)
     {
         Clause& c = operator[](cr);
         
         if (c.reloced()) { cr = c.relocation(); return; }
+        assert(&to != this); // (in place: every reachable clause has been forwarded)
         
         cr = to.alloc(c, c.learnt(), c.wasImported());
         c.relocate(cr);
@@ -322,18 +455,63 @@ class ClauseAllocator : public RegionAllocator<uint32_t>
         // (This could be cleaned-up. Generalize Clause-constructor to be applicable here instead?)
         to[cr].mark(c.mark());
         if (to[cr].learnt())        {
-	  to[cr].activity() = c.activity();
-	  to[cr].setLBD(c.lbd());
-	  to[cr].setExported(c.getExported());
+	  to.activity(to[cr]) = activity(c);
+	  to.setLBD(to[cr], lbd(c));
+	  to.setExported(to[cr], getExported(c));
 	  to[cr].setOneWatched(c.getOneWatched());
 	  to[cr].setSeen(c.getSeen());
 	  to[cr].setSizeWithoutSelectors(c.sizeWithoutSelectors());
-	  to[cr].setCanBeDel(c.canBeDel());
+	  to.setCanBeDel(to[cr], canBeDel(c));
 	  if (c.wasImported()) {
              to[cr].setImportedFrom(c.importedFrom());
 	  }
 	}
         else if (to[cr].has_extra()) to[cr].calcAbstraction();
+        if (clause_ids) to.setId(to[cr], id(c));
+    }
+
+    // In place (sliding) garbage collection, which does not need a second region:
+    //   1. forward(cs), where 'cs' holds every clause that may still be referenced: the new position
+    //      of each clause is stored in its relocation field,
+    //   2. reloc(cr, *this) on all references, as for a copying collection,
+    //   3. compact(): clauses are slid down to their new position, in address order.
+    void forward(vec<CRef>& cs)
+    {
+        sort(cs);
+        fwd_refs.clear();
+        fwd_lits.clear();
+        Size to = 0;
+        for (int i = 0; i < cs.size() && cs[i] != CRef_Undef; i++){
+            if (i > 0 && cs[i] == cs[i-1]) continue;
+            Clause& c = operator[](cs[i]);
+            assert(!c.reloced());
+            fwd_refs.push(cs[i]);
+            fwd_lits.push(c[0]);
+            c.relocate((CRef)(to >> Ref_Shift));
+            to += blocks(clauseWords(c, c.header.extra_size));
+        }
+    }
+
+    void compact(bool release_memory)
+    {
+        Size to = 0;
+        for (int i = 0; i < fwd_refs.size(); i++){
+            Clause& c     = operator[](fwd_refs[i]);
+            CRef    cr    = c.relocation();
+            int     words = clauseWords(c, c.header.extra_size);
+            c.header.reloced = 0;
+            c[0] = fwd_lits[i];
+            if (cr != fwd_refs[i])
+                memmove(lea(cr), &c, sizeof(uint32_t)*words);
+#ifdef LEARNTS_METADATA_TABLE
+            if (operator[](cr).learnt())
+                meta(operator[](cr)).cref = cr;
+#endif
+            to = ((Size)cr << Ref_Shift) + blocks(words);
+        }
+        fwd_refs.clear(true);
+        fwd_lits.clear(true);
+        RegionAllocator<uint32_t>::compacted(to, release_memory);
     }
 };
 
@@ -0,0 +1,141 @@
+/****************************************************************************************[VMTFQueue.h]
+ Glucose -- Copyright (c) 2009-2014, Gilles Audemard, Laurent Simon
+                                CRIL - Univ. Artois, France
+                                LRI  - Univ. Paris Sud, France (2009-2013)
+                                Labri - Univ. Bordeaux, France
+
+ Syrup (Glucose Parallel) -- Copyright (c) 2013-2014, Gilles Audemard, Laurent Simon
+                                CRIL - Univ. Artois, France
+                                Labri - Univ. Bordeaux, France
+
+Glucose sources are based on MiniSat (see below MiniSat copyrights). Permissions and copyrights of
+Glucose (sources until 2013, Glucose 3.0, single core) are exactly the same as Minisat on which it 
+is based on. (see below).
+
+Glucose-Syrup sources are based on another copyright. Permissions and copyrights for the parallel
+version of Glucose-Syrup (the "Software") are granted, free of charge, to deal with the Software
+without restriction, including the rights to use, copy, modify, merge, publish, distribute,
+sublicence, and/or sell copies of the Software, and to permit persons to whom the Software is 
+furnished to do so, subject to the following conditions:
+
+- The above and below copyrights notices and this permission notice shall be included in all
+copies or substantial portions of the Software;
+- The parallel version of Glucose (all files modified since Glucose 3.0 releases, 2013) cannot
+be used in any competitive event (sat competitions/evaluations) without the express permission of 
+the authors (Gilles Audemard / Laurent Simon). This is also the case for any competitive event
+using Glucose Parallel as an embedded SAT engine (single core or not).
+
+
+--------------- Original Minisat Copyrights
+
+Copyright (c) 2003-2006, Niklas Een, Niklas Sorensson
+Copyright (c) 2007-2010, Niklas Sorensson
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef Glucose_VMTFQueue_h
+#define Glucose_VMTFQueue_h
+
+#include "mtl/Vec.h"
+#include "mtl/Sort.h"
+#include "core/SolverTypes.h"
+
+namespace Glucose {
+
+//=================================================================================================
+// VMTFQueue -- decision queue with the variable move-to-front heuristic. Variables are kept in a
+// doubly linked list ordered by the time of their last bump; the next decision is the most recently
+// bumped unassigned variable. Bumping a variable moves it to the end of the list in O(1). Every
+// variable after 'cursor' is assigned (or not a decision variable), so decisions walk backwards from
+// there and backtracking only has to move the cursor.
+
+class VMTFQueue {
+    struct Link { Var prev, next; };
+
+    vec<Link>     links;
+    vec<uint64_t> stamp;            // Time of the last bump (increasing along the list)
+    uint64_t      stamps;
+    Var           first, last;      // 'last' is the most recently bumped variable
+    Var           cursor;
+    vec<Var>      bumped;           // Variables to move at the next update()
+
+    struct StampLt {
+        const vec<uint64_t>& stamp;
+        StampLt(const vec<uint64_t>& s) : stamp(s) {}
+        bool operator () (Var x, Var y) const { return stamp[x] < stamp[y]; } };
+
+    void dequeue(Var v) {
+        Link& l = links[v];
+        if (l.prev != var_Undef) links[l.prev].next = l.next; else first = l.next;
+        if (l.next != var_Undef) links[l.next].prev = l.prev; else last  = l.prev; }
+
+    void enqueue(Var v) {
+        Link& l = links[v];
+        l.prev = last; l.next = var_Undef;
+        if (last != var_Undef) links[last].next = v; else first = v;
+        last = v;
+        stamp[v] = ++stamps; }
+
+public:
+    VMTFQueue() : stamps(0), first(var_Undef), last(var_Undef), cursor(var_Undef) {}
+
+    void init(Var v) {
+        links.push();
+        stamp.push(0);
+        enqueue(v);
+        cursor = v; }
+
+    // Move 'v' to the end of the queue, at the next update(). The variables bumped together keep
+    // their relative order:
+    void bump(Var v) { bumped.push(v); }
+
+    template<class Values>
+    void update(const Values& assigns) {
+        sort(bumped, StampLt(stamp));
+        for (int i = 0; i < bumped.size(); i++){
+            Var v = bumped[i];
+            if (v != last) { dequeue(v); enqueue(v); }
+            if (assigns[v] == l_Undef) cursor = v; }
+        bumped.clear(); }
+
+    // 'v' has been unassigned (or may be picked again):
+    void unassign(Var v) {
+        if (cursor == var_Undef || stamp[v] > stamp[cursor]) cursor = v; }
+
+    // Restart the search for decisions from the end of the queue:
+    void reset() { cursor = last; }
+
+    // The most recently bumped unassigned decision variable (var_Undef if there is none):
+    template<class Values>
+    Var next(const Values& assigns, const vec<char>& decision) {
+        while (cursor != var_Undef && (assigns[cursor] != l_Undef || !decision[cursor]))
+            cursor = links[cursor].prev;
+        return cursor; }
+
+    void copyTo(VMTFQueue& copy) const {
+        links.memCopyTo(copy.links);
+        stamp.memCopyTo(copy.stamp);
+        copy.stamps = stamps;
+        copy.first  = first;
+        copy.last   = last;
+        copy.cursor = cursor; }
+};
+
+//=================================================================================================
+}
+
+#endif
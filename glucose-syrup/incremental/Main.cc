@@ -35,6 +35,17 @@ void printStats(Solver& solver)
     printf("c propagations          : %-12" PRIu64"   (%.0f /sec)\n", solver.propagations, solver.propagations/cpu_time);
     printf("c conflict literals     : %-12" PRIu64"   (%4.2f %% deleted)\n", solver.tot_literals, (solver.max_literals - solver.tot_literals)*100 / (double)solver.max_literals);
     printf("c nb reduced Clauses    : %" PRIu64"\n",solver.nbReducedClauses);
+#ifdef PROFILE_PHASES
+    solver.phaseTimers.print();
+    printf("c phase times (JSON)    : "); solver.phaseTimers.printJSON(stdout); printf("\n");
+#endif
+    if (solver.nbLocalSearches > 0)
+        printf("c local searches        : %" PRIu64" (%" PRIu64" flips, %d unsat clauses at the last one)\n", solver.nbLocalSearches, solver.lsFlipsTotal, solver.lsLastUnsat);
+    if (solver.nCards() > 0)
+        printf("c cardinality           : %d constraints, %" PRIu64" propagations, %" PRIu64" explanations\n", solver.nCards(), solver.nbCardPropagations, solver.nbCardExplanations);
+    if (solver.nXors() > 0)
+        printf("c XOR constraints       : %d constraints, %" PRIu64" eliminations, %" PRIu64" propagations, %" PRIu64" conflicts, %" PRIu64" explanations\n",
+               solver.nXors(), solver.nbGaussEliminations, solver.nbXorPropagations, solver.nbXorConflicts, solver.nbXorExplanations);
     
     if (mem_used != 0) printf("Memory used           : %.2f MB\n", mem_used);
     printf("c CPU time              : %g s\n", cpu_time);
@@ -58,6 +69,14 @@ static void SIGINT_exit(int signum) {
     _exit(1); }
 
 
+FILE *statsJSON = NULL; // Statistics of each solve call (one line of JSON)
+int solveCalls = 0;
+double solveWallLimit = 0; // Wall-clock limit of each solve call (0 = none)
+const char *loadState = NULL; // Heuristic state loaded before the first solve call
+const char *saveState = NULL; // Heuristic state saved after each solve call
+int stateLearnts = 0, stateLBD = 0;
+int backboneChunk = 64; // Candidates tested at once by a backbone command
+
 int *buffer;
 int length;
 int offset;
@@ -109,21 +128,41 @@ void putInt(int value) {
   outbuffer[outoffset++]=value;
 }
 
+// The server adds variables of its own (MaxSAT relaxations), so the variables of the client are
+// mapped to the ones of the solver.
+vec<Var> solverVars; // Solver variable of each client variable
+vec<int> clientVars; // Client variable of each solver variable (0 for the ones of the server)
+
+Var getVar(Solver *solver, int var) {
+  while (var > solverVars.size()) {
+    Var v = solver->newVar();
+    solverVars.push(v);
+    clientVars.growTo(v+1, 0);
+    clientVars[v] = solverVars.size();
+  }
+  return solverVars[var-1];
+}
+
+Lit getLit(Solver *solver, int lit) {
+  return (lit>0) ? mkLit(getVar(solver, lit)) : ~mkLit(getVar(solver, -lit));
+}
+
+void putModel(Solver *solver) {
+  putInt(solverVars.size());
+  for(int i=0;i<solverVars.size();i++) {
+    putInt(solver->model[solverVars[i]]==l_True);
+  }
+}
+
 void readClauses(Solver *solver) {
   vec<Lit> clause;
-  int numvars = solver->nVars();
   bool haveClause = false;
 	fprintf(stderr,"Let's read clauses ...\n");
   while(true) {
     int lit=getInt();
     if (lit!=0) {
 //	fprintf(stderr,"%d ", lit);
-      int var = abs(lit) - 1;
-      while (var >= numvars) {
-        numvars++;
-        solver->newVar();
-      }
-      clause.push( (lit>0) ? mkLit(var) : ~mkLit(var));
+      clause.push(getLit(solver, lit));
       haveClause = true;
     } else {
 //	    fprintf(stderr, "\n");
@@ -145,16 +184,34 @@ void processCommands(SimpSolver *solver) {
     int command=getInt();
     switch(command) {
     case IS_FREEZE: {
-      int var=getInt()-1;
+      Var var=getVar(solver, getInt());
 //      fprintf(stderr, "Freezing %d\n", var);
       solver->setFrozen(var, true);
       break;
     }
+    case IS_ATMOST: {
+      int k=getInt();
+      int size=getInt();
+      vec<Lit> lits;
+      for(int i=0;i<size;i++)
+        lits.push(getLit(solver, getInt()));
+      solver->addAtMost_(lits, k);
+      break;
+    }
     case IS_RUNSOLVER: {
       vec<Lit> dummy;
 //      SimpSolver* solver2 = (SimpSolver*)solver->clone();
       double time1 = cpuTime();
+      if (solveWallLimit > 0)
+        solver->setTimeBudget(solveWallLimit);
+      if (loadState != NULL && solveCalls == 0 && !solver->loadState(loadState))
+        fprintf(stderr, "c WARNING! Could not load the state file: %s\n", loadState);
       lbool ret = solver->solveLimited(dummy);
+      solveCalls++;
+      if (statsJSON != NULL) solver->printStatsJSON(statsJSON, solveCalls, ret);
+      // After each call: the server is killed when its input closes
+      if (saveState != NULL && !solver->saveState(saveState, stateLearnts, stateLBD))
+        fprintf(stderr, "c WARNING! Could not save the state file: %s\n", saveState);
 //      double time2 = cpuTime();
 //      vec<Lit> dummy2;
 //      lbool ret2 = solver2->solveLimited(dummy2);
@@ -162,10 +219,7 @@ void processCommands(SimpSolver *solver) {
 //      fprintf( stderr, "First execution time: %f\t second execution time: %f\n", time2 - time1, time3-time2);
       if (ret == l_True) {
         putInt(IS_SAT);
-        putInt(solver->nVars());
-        for(int i=0;i<solver->nVars();i++) {
-          putInt(solver->model[i]==l_True);
-        }
+        putModel(solver);
       } else if (ret == l_False) {
         putInt(IS_UNSAT);
 	putInt(solver->assumptionsSize());
@@ -183,6 +237,64 @@ void processCommands(SimpSolver *solver) {
       flushInts();
       return;
     }
+    case IS_BACKBONE: {
+      int size=getInt();
+      vec<Var> vars;
+      for(int i=0;i<size;i++)
+        vars.push(getVar(solver, getInt()));
+      if (solveWallLimit > 0)
+        solver->setTimeBudget(solveWallLimit);
+      if (loadState != NULL && solveCalls == 0 && !solver->loadState(loadState))
+        fprintf(stderr, "c WARNING! Could not load the state file: %s\n", loadState);
+      vec<Lit> backbone;
+      lbool ret = solver->backbone(vars, backbone, backboneChunk);
+      solveCalls++;
+      if (statsJSON != NULL) solver->printStatsJSON(statsJSON, solveCalls, ret);
+      if (saveState != NULL && !solver->saveState(saveState, stateLearnts, stateLBD))
+        fprintf(stderr, "c WARNING! Could not save the state file: %s\n", saveState);
+      if (ret == l_True) {
+        putInt(IS_SAT);
+        putInt(backbone.size());
+        for(int i=0;i<backbone.size();i++)
+          putInt(sign(backbone[i]) ? -clientVars[var(backbone[i])] : clientVars[var(backbone[i])]);
+      } else if (ret == l_False) {
+        putInt(IS_UNSAT);
+      } else {
+        putInt(IS_INDETER);
+      }
+      flushInts();
+      return;
+    }
+    case IS_MAXSAT: {
+      int nsoft=getInt();
+      vec<Lit> softs;
+      vec<int64_t> weights;
+      for(int i=0;i<nsoft;i++) {
+        weights.push(getInt());
+        int size=getInt();
+        for(int j=0;j<size;j++)
+          softs.push(getLit(solver, getInt()));
+        softs.push(lit_Undef);
+      }
+      if (solveWallLimit > 0)
+        solver->setTimeBudget(solveWallLimit);
+      int64_t cost = 0;
+      lbool ret = solver->maxsat(softs, weights, cost);
+      solveCalls++;
+      if (statsJSON != NULL) solver->printStatsJSON(statsJSON, solveCalls, ret);
+      if (ret == l_True) {
+        putInt(IS_SAT);
+        putInt((int)(cost >> 32));
+        putInt((int)(cost & 0xffffffff));
+        putModel(solver);
+      } else if (ret == l_False) {
+        putInt(IS_UNSAT);
+      } else {
+        putInt(IS_INDETER);
+      }
+      flushInts();
+      return;
+    }
     default:
       fprintf(stderr, "Unreconized command\n");
       exit(-1);
@@ -234,9 +346,18 @@ int main(int argc, char** argv) {
     StringOption dimacs ("MAIN", "dimacs", "If given, stop after preprocessing and write the result to this file.");
     IntOption    cpu_lim("MAIN", "cpu-lim","Limit on CPU time allowed in seconds.\n", INT32_MAX, IntRange(0, INT32_MAX));
     IntOption    mem_lim("MAIN", "mem-lim","Limit on memory usage in megabytes.\n", INT32_MAX, IntRange(0, INT32_MAX));
+    DoubleOption wall_lim("MAIN", "wall-lim","Limit on the wall-clock time of each solve call in seconds (0=none). Past it, the call answers INDETERMINATE.\n", 0, DoubleRange(0, true, HUGE_VAL, false));
+    StringOption stats_json("MAIN", "stats-json", "If given, append the statistics of each solve call to this file (one line of JSON).");
+    StringOption load_state("MAIN", "load-state", "If given, start the first solve call from the activities, phases, frozen variables and learnts saved in this file (keyed by solver variable: the client's ones until a MaxSAT call adds variables).");
+    StringOption save_state("MAIN", "save-state", "If given, save the activities, phases and frozen variables to this file after each solve call (keyed by solver variable, see load-state).");
+    IntOption    state_learnts("MAIN", "state-learnts", "Number of learnts saved with the state (the ones of lowest LBD).\n", 0, IntRange(0, INT32_MAX));
+    IntOption    state_lbd("MAIN", "state-lbd", "Maximal LBD of the learnts saved with the state.\n", 3, IntRange(1, INT32_MAX));
+    IntOption    backbone_chunk("MAIN", "backbone-chunk", "Number of backbone candidates tested by a single solve call.\n", 64, IntRange(1, INT32_MAX));
     
     BoolOption    opt_certified      (_certified, "certified",    "Certified UNSAT using DRUP format", false);
     StringOption  opt_certified_file      (_certified, "certified-output",    "Certified UNSAT output file", "NULL");
+    BoolOption    opt_certified_binary    (_certified, "certified-binary",    "Write the proof in binary DRAT format", false);
+    BoolOption    opt_certified_thread    (_certified, "certified-thread",    "Write the proof from a background thread", false);
          
     parseOptions(argc, argv, true);
     
@@ -245,6 +366,30 @@ int main(int argc, char** argv) {
     S.verbosity = verb;
     S.verbEveryConflicts = vv;
     S.showModel = mod;
+    S.restore_elim = true; // MaxSAT and backbone commands may bring back the eliminated variables of the client
+    // The proof is flushed at the end of each solve (the server exits as soon as its input closes)
+    S.certifiedUNSAT = opt_certified;
+    S.certifiedBinary = opt_certified_binary;
+    S.certifiedThread = opt_certified_thread;
+    if (S.certifiedUNSAT) {
+      if (!strcmp(opt_certified_file, "NULL"))
+        S.certifiedOutput = fopen("/dev/stdout", "wb");
+      else
+        S.certifiedOutput = fopen(opt_certified_file, "wb");
+      if (!S.certifiedBinary)
+        fprintf(S.certifiedOutput, "o proof DRUP\n");
+    }
+    solveWallLimit = wall_lim;
+    loadState = load_state;
+    saveState = save_state;
+    stateLearnts = state_learnts;
+    stateLBD = state_lbd;
+    backboneChunk = backbone_chunk;
+    if (stats_json) {
+      statsJSON = fopen(stats_json, "a");
+      if (statsJSON == NULL)
+        printf("c WARNING! Could not open the statistics file: %s\n", (const char*)stats_json);
+    }
     solver = &S;
     // Use signal handlers that forcibly quit until the solver will be
     // able to respond to interrupts:
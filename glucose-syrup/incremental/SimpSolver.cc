@@ -47,6 +47,8 @@ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,
 OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  **************************************************************************************************/
 
+#include <string.h>
+
 #include "mtl/Sort.h"
 #include "simp/SimpSolver.h"
 #include "utils/System.h"
@@ -65,6 +67,9 @@ static BoolOption   opt_use_elim         (_cat, "elim",         "Perform variabl
 static IntOption    opt_grow             (_cat, "grow",         "Allow a variable elimination step to grow by a number of clauses.", 0);
 static IntOption    opt_clause_lim       (_cat, "cl-lim",       "Variables are not eliminated if it produces a resolvent with a length above this limit. -1 means no limit", 20,   IntRange(-1, INT32_MAX));
 static IntOption    opt_subsumption_lim  (_cat, "sub-lim",      "Do not check if subsumption against a clause larger than this. -1 means no limit.", 1000, IntRange(-1, INT32_MAX));
+static IntOption    opt_xor_size         (_cat, "xor-size",     "Largest XOR constraints looked for in the clauses (with -gauss).", 6, IntRange(3, 8));
+static BoolOption   opt_maxsat_strat     (_cat, "maxsat-strat", "Stratify the weights of the soft clauses (MaxSAT).", true);
+static IntOption    opt_maxsat_min       (_cat, "maxsat-min",   "Conflicts allowed to drop each literal of a MaxSAT core (0=no core minimization).", 1000, IntRange(0, INT32_MAX));
 static DoubleOption opt_simp_garbage_frac(_cat, "simp-gc-frac", "The fraction of wasted memory allowed before a garbage collection is triggered during simplification.",  0.5, DoubleRange(0, false, HUGE_VAL, false));
 
 
@@ -81,6 +86,10 @@ SimpSolver::SimpSolver() :
   , use_asymm          (opt_use_asymm)
   , use_rcheck         (opt_use_rcheck)
   , use_elim           (opt_use_elim)
+  , restore_elim       (false)
+  , xor_size           (opt_xor_size)
+  , maxsat_strat       (opt_maxsat_strat)
+  , maxsat_min         (opt_maxsat_min)
   , merges             (0)
   , asymm_lits         (0)
   , eliminated_vars    (0)
@@ -90,6 +99,7 @@ SimpSolver::SimpSolver() :
   , elim_heap          (ElimLt(n_occ))
   , bwdsub_assigns     (0)
   , n_touched          (0)
+  , xors_searched      (false)
 {
     vec<Lit> dummy(1,lit_Undef);
     ca.extra_clause_field = true; // NOTE: must happen before allocating the dummy clause below.
@@ -112,6 +122,10 @@ SimpSolver::SimpSolver(const SimpSolver &s) : Solver(s)
   , use_asymm          (s.use_asymm)
   , use_rcheck         (s.use_rcheck)
   , use_elim           (s.use_elim)
+  , restore_elim       (s.restore_elim)
+  , xor_size           (s.xor_size)
+  , maxsat_strat       (s.maxsat_strat)
+  , maxsat_min         (s.maxsat_min)
   , merges             (s.merges)
   , asymm_lits         (s.asymm_lits)
   , eliminated_vars    (s.eliminated_vars)
@@ -121,6 +135,7 @@ SimpSolver::SimpSolver(const SimpSolver &s) : Solver(s)
   , elim_heap          (ElimLt(n_occ))
   , bwdsub_assigns     (s.bwdsub_assigns)
   , n_touched          (s.n_touched)
+  , xors_searched      (s.xors_searched)
 {
     // TODO: Copy dummy... what is it???
     vec<Lit> dummy(1,lit_Undef);
@@ -138,6 +153,9 @@ SimpSolver::SimpSolver(const SimpSolver &s) : Solver(s)
     s.subsumption_queue.copyTo(subsumption_queue);
     s.frozen.memCopyTo(frozen);
     s.eliminated.memCopyTo(eliminated);
+    s.restorable.memCopyTo(restorable);
+    s.loaded_learnts.memCopyTo(loaded_learnts);
+    s.loaded_lbds.memCopyTo(loaded_lbds);
 
     use_simplification = s.use_simplification;
     bwdsub_assigns = s.bwdsub_assigns;
@@ -153,6 +171,7 @@ Var SimpSolver::newVar(bool sign, bool dvar) {
     Var v = Solver::newVar(sign, dvar);
     frozen    .push((char)false);
     eliminated.push((char)false);
+    restorable.push((char)false);
 
     if (use_simplification){
         n_occ     .push(0);
@@ -186,6 +205,9 @@ lbool SimpSolver::solve_(bool do_simp, bool turn_off_simp)
         result = lbool(eliminate(turn_off_simp));
     }
 
+    if (result == l_True && loaded_learnts.size() > 0)
+        result = lbool(addLoadedLearnts());
+
     if (result == l_True)
         result = Solver::solve_();
     else if (verbosity >= 1)
@@ -205,6 +227,305 @@ lbool SimpSolver::solve_(bool do_simp, bool turn_off_simp)
 
 
 
+/*_________________________________________________________________________________________________
+|
+|  backbone : (vs : const vec<Var>&) (out : vec<Lit>&) (chunk : int)  ->  [lbool]
+|  
+|  Description:
+|    Put in 'out' the literals over 'vs' that are true in all the models. The candidates are the
+|    literals of a first model; each new model filters out the ones it falsifies. The remaining
+|    ones are tested by assuming the negation of up to 'chunk' of them at once: a final conflict of
+|    a single literal is in the backbone and is added as a unit, a larger one halves the chunk.
+|    The learnts are kept from one call to the next. The eliminated variables of 'vs' are restored
+|    first (see 'restoreVars()'). Returns l_False if there is no model, and l_Undef if the budget is
+|    exhausted or an eliminated variable cannot be restored.
+|________________________________________________________________________________________________@*/
+lbool SimpSolver::backbone(const vec<Var>& vs, vec<Lit>& out, int chunk)
+{
+    vec<Lit> cands, assumps;
+    int      i, j, size = chunk;
+
+    out.clear();
+    if (!restoreVars(vs)){
+        if (verbosity >= 1) printf("c The backbone has eliminated variables that cannot be restored\n");
+        return l_Undef; }
+    for (i = 0; i < vs.size(); i++)
+        setFrozen(vs[i], true);
+
+    lbool ret = solveLimited(assumps);
+    if (ret != l_True) return ret;
+    for (i = 0; i < vs.size(); i++)
+        if (model[vs[i]] != l_Undef)
+            cands.push(mkLit(vs[i], model[vs[i]] == l_False));
+
+    while (cands.size() > 0){
+        // The candidates fixed at level 0 are in the backbone:
+        for (i = j = 0; i < cands.size(); i++)
+            if (value(cands[i]) == l_True) out.push(cands[i]);
+            else cands[j++] = cands[i];
+        cands.shrink(i - j);
+        if (cands.size() == 0) break;
+
+        assumps.clear();
+        for (i = cands.size() - 1; i >= 0 && assumps.size() < size; i--)
+            assumps.push(~cands[i]);
+
+        ret = solveLimited(assumps, false);
+        if (ret == l_Undef) return l_Undef;
+        if (ret == l_True){
+            // Model filtering:
+            for (i = j = 0; i < cands.size(); i++)
+                if (modelValue(cands[i]) == l_True) cands[j++] = cands[i];
+            cands.shrink(i - j);
+            size = chunk;
+        }else if (conflict.size() == 0)
+            return l_False;
+        else if (conflict.size() == 1){
+            if (!addClause(conflict[0])) return l_False;
+        }else
+            size = size > 1 ? size / 2 : 1;
+    }
+    return l_True;
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  maxsat : (softs : const vec<Lit>&) (weights : const vec<int64_t>&) (cost : int64_t&)  ->  [lbool]
+|  
+|  Description:
+|    Satisfy the clauses while minimizing the weight of the falsified soft clauses ('softs', each
+|    one terminated by 'lit_Undef'). Core-guided (OLL): the soft clauses are assumed through a
+|    fresh literal (their own one for the units), each final conflict is minimized then relaxed
+|    by a totalizer over its literals, whose outputs are assumed in turn. With 'maxsat_strat', only
+|    the assumptions of the highest weights are used until a model is found. The problem clauses
+|    are unchanged: the relaxation variables are free once the call is over. On l_True, 'model'
+|    is optimal and 'cost' its weight. The eliminated variables of the soft clauses are restored
+|    first (see 'restoreVars()'): l_Undef if they cannot be.
+|________________________________________________________________________________________________@*/
+lbool SimpSolver::maxsat(const vec<Lit>& softs, const vec<int64_t>& weights, int64_t& cost)
+{
+    vec<Lit>     assumps, core, lits, active;
+    vec<int64_t> weight;                // Weight of each assumption (by literal).
+    vec<int>     root, bound;           // Totalizer and index of which each variable is an output (or -1).
+    vec<int>     assumed;               // Highest output of each totalizer assumed so far.
+    vec<int64_t> tot_weight;            // Weight of each output of a totalizer.
+    vec<Var>     selectors, vs;
+    vec<lbool>   best;
+    int64_t      base = 0, lower = 0, upper = INT64_MAX, strat = 1;
+    lbool        result = l_Undef;
+    bool         do_simp = true;
+    int          i, j, s;
+
+    // The cost of a soft clause over an eliminated variable would be unknown to the search:
+    for (i = 0; i < softs.size(); i++)
+        if (softs[i] != lit_Undef) vs.push(var(softs[i]));
+    if (!restoreVars(vs)){
+        if (verbosity >= 1) printf("c The soft clauses have eliminated variables that cannot be restored\n");
+        return l_Undef; }
+
+    tot_outs.clear(true); tot_left.clear(); tot_right.clear(); tot_leaves.clear();
+
+    for (i = s = 0; s < weights.size(); i++, s++){
+        lits.clear();
+        for (; softs[i] != lit_Undef; i++){
+            setFrozen(var(softs[i]), true);
+            lits.push(softs[i]); }
+        if (weights[s] <= 0) continue;
+        if (lits.size() == 0){ base += weights[s]; continue; }
+
+        Lit a = lits[0];
+        if (lits.size() > 1){
+            Var r = newVar();
+            setFrozen(r, true);
+            selectors.push(r);
+            a = mkLit(r);
+            lits.push(~a);
+            if (!addClause_(lits)) return l_False; }
+        weight.growTo(2 * nVars(), 0);
+        if (weight[toInt(a)] == 0) active.push(a);
+        weight[toInt(a)] += weights[s];
+        if (maxsat_strat && weight[toInt(a)] > strat) strat = weight[toInt(a)];
+    }
+
+    for (;;){
+        assumps.clear();
+        for (i = j = 0; i < active.size(); i++)
+            if (weight[toInt(active[i])] > 0){
+                if (weight[toInt(active[i])] >= strat) assumps.push(active[i]);
+                active[j++] = active[i]; }
+        active.shrink(i - j);
+
+        lbool ret = solveLimited(assumps, do_simp);
+        do_simp = false;
+        if (ret == l_Undef) break;
+
+        if (ret == l_True){
+            int64_t c = 0;
+            for (i = s = 0; s < weights.size(); i++, s++){
+                bool sat = false;
+                for (; softs[i] != lit_Undef; i++)
+                    if (modelValue(softs[i]) == l_True) sat = true;
+                if (!sat && weights[s] > 0) c += weights[s]; }
+            if (c < upper){
+                upper = c;
+                model.copyTo(best);
+                if (verbosity >= 1) printf("c MaxSAT cost: %lld (lower bound %lld)\n", (long long)upper, (long long)(base + lower)); }
+
+            // Next stratum:
+            int64_t next = 0;
+            for (i = 0; i < active.size(); i++)
+                if (weight[toInt(active[i])] < strat && weight[toInt(active[i])] > next) next = weight[toInt(active[i])];
+            if (next == 0 || upper == base + lower){ result = l_True; break; }
+            strat = next;
+            continue;
+        }
+
+        if (conflict.size() == 0){ result = l_False; break; }
+        core.clear();
+        for (i = 0; i < conflict.size(); i++) core.push(~conflict[i]);
+        minimizeCore(core);
+        if (core.size() == 0){ result = l_False; break; }   // The hard clauses are unsatisfiable.
+
+        int64_t wmin = INT64_MAX;
+        for (i = 0; i < core.size(); i++)
+            if (weight[toInt(core[i])] < wmin) wmin = weight[toInt(core[i])];
+        lower += wmin;
+
+        // Relax the core: the next output of the totalizers met is assumed, and a new totalizer
+        // counts the falsified assumptions of the core (at most one is free).
+        for (i = 0; i < core.size(); i++){
+            weight[toInt(core[i])] -= wmin;
+            Var v = var(core[i]);
+            if (v < root.size() && root[v] >= 0 && bound[v] == assumed[root[v]]){
+                int t = root[v], k = bound[v] + 1;
+                if (k < tot_leaves[t] && !extendTotalizer(t, k + 1)){ result = l_False; break; }
+                if (k < tot_leaves[t]){
+                    Lit o = ~tot_outs[t][k];
+                    root.growTo(nVars(), -1); bound.growTo(nVars(), -1); weight.growTo(2 * nVars(), 0);
+                    root[var(o)] = t; bound[var(o)] = k; assumed[t] = k;
+                    weight[toInt(o)] = tot_weight[t];
+                    active.push(o); } } }
+        if (i < core.size()) break;
+
+        if (core.size() > 1){
+            lits.clear();
+            for (i = 0; i < core.size(); i++) lits.push(~core[i]);
+            int t = buildTotalizer(lits, 0, lits.size());
+            if (!extendTotalizer(t, 2)){ result = l_False; break; }
+            assumed.growTo(tot_outs.size(), -1); tot_weight.growTo(tot_outs.size(), 0);
+            Lit o = ~tot_outs[t][1];
+            root.growTo(nVars(), -1); bound.growTo(nVars(), -1); weight.growTo(2 * nVars(), 0);
+            root[var(o)] = t; bound[var(o)] = 1; assumed[t] = 1;
+            tot_weight[t] = wmin;
+            weight[toInt(o)] = wmin;
+            active.push(o); }
+
+        if (upper == base + lower){ result = l_True; break; }
+    }
+
+    // The relaxation variables can be eliminated by the next calls:
+    for (i = 0; i < selectors.size(); i++) setFrozen(selectors[i], false);
+    for (i = 0; i < tot_outs.size(); i++)
+        if (tot_left[i] >= 0)
+            for (j = 0; j < tot_outs[i].size(); j++) setFrozen(var(tot_outs[i][j]), false);
+
+    if (best.size() > 0){
+        best.copyTo(model);
+        cost = upper; }
+    return result;
+}
+
+
+// Drop the literals of 'core' one at a time, with at most 'maxsat_min' conflicts to refute the rest.
+// 'core' ends empty if the clauses alone are found unsatisfiable.
+void SimpSolver::minimizeCore(vec<Lit>& core)
+{
+    vec<Lit> assumps;
+    int64_t  budget = conflict_budget;
+
+    if (maxsat_min == 0) return;
+    for (int i = 0; i < core.size() && core.size() > 1;){
+        assumps.clear();
+        for (int j = 0; j < core.size(); j++)
+            if (j != i) assumps.push(core[j]);
+        setConfBudget(maxsat_min);
+        if (solveLimited(assumps, false) == l_False){
+            core.clear();
+            for (int j = 0; j < conflict.size(); j++) core.push(~conflict[j]);
+        }else
+            i++;
+    }
+    conflict_budget = budget;
+}
+
+
+// Node of a totalizer over 'ins[from..to-1]' (its outputs are added by 'extendTotalizer()').
+int SimpSolver::buildTotalizer(const vec<Lit>& ins, int from, int to)
+{
+    int t = tot_outs.size();
+    tot_outs.push();
+    tot_left.push(-1);
+    tot_right.push(-1);
+    tot_leaves.push(to - from);
+    if (to - from == 1)
+        tot_outs[t].push(ins[from]);
+    else{
+        int mid = (from + to) / 2;
+        int l = buildTotalizer(ins, from, mid);
+        int r = buildTotalizer(ins, mid, to);
+        tot_left[t] = l;
+        tot_right[t] = r; }
+    return t;
+}
+
+
+// Give node 't' its outputs up to 'k' true inputs: '(~l_i | ~r_j | o_i+j)' for the new sums only,
+// as the outputs of the children below the previous bound were already combined.
+bool SimpSolver::extendTotalizer(int t, int k)
+{
+    vec<Lit> lits;
+    int      old = tot_outs[t].size();
+
+    if (k > tot_leaves[t]) k = tot_leaves[t];
+    if (k <= old) return true;
+    int l = tot_left[t], r = tot_right[t];
+    if (!extendTotalizer(l, k) || !extendTotalizer(r, k)) return false;
+    while (tot_outs[t].size() < k){
+        Var v = newVar();
+        setFrozen(v, true);
+        tot_outs[t].push(mkLit(v)); }
+
+    for (int i = 0; i <= tot_outs[l].size(); i++)
+        for (int j = 0; j <= tot_outs[r].size(); j++){
+            if (i + j <= old || i + j > k) continue;
+            lits.clear();
+            if (i > 0) lits.push(~tot_outs[l][i - 1]);
+            if (j > 0) lits.push(~tot_outs[r][j - 1]);
+            lits.push(tot_outs[t][i + j - 1]);
+            if (!addClause_(lits)) return false; }
+    return true;
+}
+
+
+bool SimpSolver::addAtMost_(vec<Lit>& ps, int k)
+{
+    for (int i = 0; i < ps.size(); i++) {
+        assert(!isEliminated(var(ps[i])));
+        setFrozen(var(ps[i]), true);
+    }
+    return Solver::addAtMost_(ps, k);
+}
+
+
+void SimpSolver::observe(Var v)
+{
+    assert(!isEliminated(v));
+    setFrozen(v, true);
+    Solver::observe(v);
+}
+
+
 bool SimpSolver::addClause_(vec<Lit>& ps)
 {
 #ifndef NDEBUG
@@ -219,11 +540,8 @@ bool SimpSolver::addClause_(vec<Lit>& ps)
     if (!Solver::addClause_(ps))
         return false;
 
-    if(!parsing && certifiedUNSAT) {
-      for (int i = 0; i < ps.size(); i++)
-        fprintf(certifiedOutput, "%i " , (var(ps[i]) + 1) * (-2 * sign(ps[i]) + 1) );
-      fprintf(certifiedOutput, "0\n");
-    }
+    if(!parsing && certifiedUNSAT && !certifiedLRAT)
+      proof().addClause(ps);
 
     if (use_simplification && clauses.size() == nclauses + 1){
         CRef          cr = clauses.last();
@@ -276,22 +594,15 @@ bool SimpSolver::strengthenClause(CRef cr, Lit l)
     // if (!find(subsumption_queue, &c))
     subsumption_queue.insert(cr);
 
-    if (certifiedUNSAT) {
-      for (int i = 0; i < c.size(); i++)
-        if (c[i] != l) fprintf(certifiedOutput, "%i " , (var(c[i]) + 1) * (-2 * sign(c[i]) + 1) );
-      fprintf(certifiedOutput, "0\n");
-    }
+    if (certifiedUNSAT)
+      proof().addClause(c, l);
 
     if (c.size() == 2){
         removeClause(cr);
         c.strengthen(l);
     }else{
-        if (certifiedUNSAT) {
-          fprintf(certifiedOutput, "d ");
-          for (int i = 0; i < c.size(); i++)
-            fprintf(certifiedOutput, "%i " , (var(c[i]) + 1) * (-2 * sign(c[i]) + 1) );
-          fprintf(certifiedOutput, "0\n");
-        }
+        if (certifiedUNSAT)
+          proof().deleteClause(c);
 
         detachClause(cr, true);
         c.strengthen(l);
@@ -424,8 +735,8 @@ bool SimpSolver::backwardSubsumptionCheck(bool verbose)
 
     while (subsumption_queue.size() > 0 || bwdsub_assigns < trail.size()){
 
-        // Empty subsumption queue and return immediately on user-interrupt:
-        if (asynch_interrupt){
+        // Empty subsumption queue and return immediately on user-interrupt (or past the deadline):
+        if (interrupted()){
             subsumption_queue.clear();
             bwdsub_assigns = trail.size();
             break; }
@@ -589,11 +900,20 @@ bool SimpSolver::eliminateVar(Var v)
     setDecisionVar(v, false);
     eliminated_vars++;
 
+    // With 'restore_elim', the larger side is stored as well (first: it is only needed to
+    // restore 'v', the model is extended by the smaller side):
+    restorable[v] = restore_elim;
     if (pos.size() > neg.size()){
+        if (restore_elim)
+            for (int i = 0; i < pos.size(); i++)
+                mkElimClause(elimclauses, v, ca[pos[i]]);
         for (int i = 0; i < neg.size(); i++)
             mkElimClause(elimclauses, v, ca[neg[i]]);
         mkElimClause(elimclauses, mkLit(v));
     }else{
+        if (restore_elim)
+            for (int i = 0; i < neg.size(); i++)
+                mkElimClause(elimclauses, v, ca[neg[i]]);
         for (int i = 0; i < pos.size(); i++)
             mkElimClause(elimclauses, v, ca[pos[i]]);
         mkElimClause(elimclauses, ~mkLit(v));
@@ -616,6 +936,8 @@ bool SimpSolver::eliminateVar(Var v)
     // Free watchers lists for this variable, if possible:
     if (watches[ mkLit(v)].size() == 0) watches[ mkLit(v)].clear(true);
     if (watches[~mkLit(v)].size() == 0) watches[~mkLit(v)].clear(true);
+    if (watchesTer[ mkLit(v)].size() == 0) watchesTer[ mkLit(v)].clear(true);
+    if (watchesTer[~mkLit(v)].size() == 0) watchesTer[~mkLit(v)].clear(true);
 
     return backwardSubsumptionCheck();
 }
@@ -655,6 +977,78 @@ bool SimpSolver::substitute(Var v, Lit x)
 }
 
 
+/*_________________________________________________________________________________________________
+|
+|  restoreVars : (vs : const vec<Var>&)  ->  [bool]
+|  
+|  Description:
+|    Make the eliminated variables of 'vs' real variables again, by putting their stored clauses
+|    back into the solver. A stored clause can have variables eliminated later, which are then
+|    restored too. Needs both sides of their clauses ('restore_elim' when they were eliminated):
+|    returns false, without changing anything, if one of them is not restorable. Also false with
+|    a proof, where the clauses put back could not be justified. At decision level 0.
+|________________________________________________________________________________________________@*/
+bool SimpSolver::restoreVars(const vec<Var>& vs)
+{
+    vec<char> restore(nVars(), 0);
+    vec<int>  ends;                     // End of each record of the stack (its size is stored there).
+    vec<Lit>  cl;
+    int       nrestore = 0, i, j;
+    bool      changed;
+
+    assert(decisionLevel() == 0);
+    for (i = 0; i < vs.size(); i++)
+        if (isEliminated(vs[i]) && !restore[vs[i]]){
+            if (!restorable[vs[i]] || certifiedUNSAT) return false;
+            restore[vs[i]] = 1;
+            nrestore++; }
+    if (nrestore == 0) return true;
+
+    for (i = elimclauses.size() - 1; i > 0; i -= elimclauses[i] + 1)
+        ends.push(i);
+
+    // The variables eliminated after a restored one, in one of its clauses, are restored as well:
+    do{
+        changed = false;
+        for (i = 0; i < ends.size(); i++){
+            int size = elimclauses[ends[i]], first = ends[i] - size;
+            if (!restore[var(toLit(elimclauses[first]))]) continue;
+            for (j = first + 1; j < ends[i]; j++){
+                Var u = var(toLit(elimclauses[j]));
+                if (isEliminated(u) && !restore[u]){
+                    if (!restorable[u]) return false;
+                    restore[u] = 1;
+                    nrestore++;
+                    changed = true; } } }
+    }while (changed);
+
+    for (Var v = 0; v < nVars(); v++)
+        if (restore[v]){
+            eliminated[v] = false;
+            restorable[v] = false;
+            eliminated_vars--;
+            setDecisionVar(v, true);
+            if (use_simplification) updateElimHeap(v); }
+
+    // Remove their records from the stack (oldest first), and add back the clauses:
+    int k = 0;
+    for (i = ends.size() - 1; i >= 0; i--){
+        int size = elimclauses[ends[i]], first = ends[i] - size;
+        if (!restore[var(toLit(elimclauses[first]))]){
+            for (j = first; j <= ends[i]; j++)
+                elimclauses[k++] = elimclauses[j];
+        }else if (size > 1 && ok){      // A unit record only gives the default value.
+            cl.clear();
+            for (j = first; j < ends[i]; j++)
+                cl.push(toLit(elimclauses[j]));
+            addClause_(cl); } }
+    elimclauses.shrink(elimclauses.size() - k);
+
+    if (verbosity >= 1) printf("c Restored %d eliminated variables\n", nrestore);
+    return true;
+}
+
+
 void SimpSolver::extendModel()
 {
     int i, j;
@@ -674,8 +1068,29 @@ void SimpSolver::extendModel()
 }
 
 
+// The reconstruction stack comes after the formula, in the order used by 'extendModel()': each
+// clause has the literal of its eliminated variable first (the units give the default values).
+
+void SimpSolver::writeDimacs(DimacsWriter& w, const vec<Lit>& assumps, int max_lbd, bool full)
+{
+    Solver::writeDimacs(w, assumps, max_lbd, full);
+    if (!full || !ok || elimclauses.size() == 0) return;
+
+    w.comment("reconstruction stack");
+    for (int i = elimclauses.size() - 1; i > 0; i--) {
+        int size = elimclauses[i];
+        w.begin('e');
+        for (int j = i - size; j < i; j++)
+            w.lit(toLit(elimclauses[j]));
+        w.end();
+        i -= size;
+    }
+}
+
+
 bool SimpSolver::eliminate(bool turn_off_elim)
 {
+    TIME_PHASE(phaseTimers, phase_eliminate);
     if (!simplify()) {
         ok = false;
         return false;
@@ -683,6 +1098,9 @@ bool SimpSolver::eliminate(bool turn_off_elim)
     else if (!use_simplification)
         return true;
 
+    if (useGauss && !certifiedUNSAT && !xors_searched)
+        findXors();
+
     // Main simplification loop:
     //
 
@@ -700,8 +1118,8 @@ bool SimpSolver::eliminate(bool turn_off_elim)
             !backwardSubsumptionCheck(true)){
             ok = false; goto cleanup; }
 
-        // Empty elim_heap and return immediately on user-interrupt:
-        if (asynch_interrupt){
+        // Empty elim_heap and return immediately on user-interrupt (or past the deadline):
+        if (interrupted()){
             assert(bwdsub_assigns == trail.size());
             assert(subsumption_queue.size() == 0);
             assert(n_touched == 0);
@@ -712,7 +1130,7 @@ bool SimpSolver::eliminate(bool turn_off_elim)
         for (int cnt = 0; !elim_heap.empty(); cnt++){
             Var elim = elim_heap.removeMin();
             
-            if (asynch_interrupt) break;
+            if (interrupted()) break;
 
             if (isEliminated(elim) || value(elim) != l_Undef) continue;
 
@@ -771,6 +1189,77 @@ bool SimpSolver::eliminate(bool turn_off_elim)
 }
 
 
+// An XOR constraint 'x1 + ... + xn = rhs' is found when the clauses over 'x1 .. xn' forbid all the
+// 2^(n-1) assignments of the wrong parity (each clause forbids the one falsifying its literals).
+// Its variables are frozen, so that its clauses stay until the search.
+struct XorCandidate { Var vars[8]; int size; unsigned forbidden; };
+
+struct XorCandidateLt {
+    bool operator () (const XorCandidate& a, const XorCandidate& b) const {
+        if (a.size != b.size) return a.size < b.size;
+        for (int i = 0; i < a.size; i++)
+            if (a.vars[i] != b.vars[i]) return a.vars[i] < b.vars[i];
+        return false; }
+};
+
+void SimpSolver::findXors()
+{
+    xors_searched = true;
+    vec<XorCandidate> cands;
+    for (int i = 0; i < clauses.size(); i++){
+        const Clause& c = ca[clauses[i]];
+        if (c.mark() || c.size() < 3 || c.size() > xor_size) continue;
+
+        XorCandidate x;
+        x.size = c.size();
+        for (int j = 0; j < c.size(); j++){
+            int k = j;
+            for (; k > 0 && x.vars[k-1] > var(c[j]); k--)
+                x.vars[k] = x.vars[k-1];
+            x.vars[k] = var(c[j]);
+        }
+        x.forbidden = 0;
+        for (int j = 0; j < c.size(); j++)
+            if (sign(c[j]))
+                for (int k = 0; k < x.size; k++)
+                    if (x.vars[k] == var(c[j])) x.forbidden |= 1 << k;
+        cands.push(x);
+    }
+    sort(cands, XorCandidateLt());
+
+    XorCandidateLt lt;
+    vec<Var> vs;
+    int found = 0;
+    for (int i = 0, j; i < cands.size(); i = j){
+        // The assignments forbidden by the clauses over the same variables as 'cands[i]':
+        uint64_t forbidden[4] = { 0, 0, 0, 0 };
+        for (j = i; j < cands.size() && !lt(cands[i], cands[j]); j++)
+            forbidden[cands[j].forbidden / 64] |= (uint64_t)1 << (cands[j].forbidden % 64);
+
+        int n = cands[i].size;
+        if (j - i < (1 << (n - 1))) continue;
+        int count[2] = { 0, 0 };
+        for (unsigned a = 0; a < (1u << n); a++)
+            if (forbidden[a / 64] & ((uint64_t)1 << (a % 64)))
+                count[__builtin_popcount(a) & 1]++;
+
+        for (int parity = 0; parity < 2; parity++)
+            if (count[parity] == (1 << (n - 1))){
+                vs.clear();
+                for (int k = 0; k < n; k++)
+                    vs.push(cands[i].vars[k]);
+                if (!addXor(vs, !parity)) return;
+                for (int k = 0; k < n; k++)
+                    setFrozen(vs[k], true);
+                found++;
+            }
+    }
+
+    if (verbosity >= 1 && found > 0)
+        printf("c |  XOR constraints:        %10d                                                                   |\n", found);
+}
+
+
 void SimpSolver::cleanUpClauses()
 {
     occurs.cleanAll();
@@ -809,18 +1298,240 @@ void SimpSolver::relocAll(ClauseAllocator& to)
 }
 
 
+void SimpSolver::liveClauses(vec<CRef>& cs)
+{
+    Solver::liveClauses(cs);
+    if (!use_simplification) return;
+
+    // (occurs lists only refer to clauses in 'clauses')
+    for (int i = 0; i < subsumption_queue.size(); i++)
+        cs.push(subsumption_queue[i]);
+    cs.push(bwdsub_tmpunit);
+}
+
+
 void SimpSolver::garbageCollect()
 {
+    TIME_PHASE(phaseTimers, phase_garbageCollect);
+    if (gc_inplace || mem_pressure > 0) {
+        cleanUpClauses();
+        ClauseAllocator::Size before = ca.size();
+        vec<CRef> cs;
+        liveClauses(cs);
+        ca.forward(cs);
+        relocAll(ca);
+        Solver::relocAll(ca);
+        ca.compact(gc_release || mem_pressure > 0);
+        if (verbosity >= 2)
+            printf("|  Garbage collection:   %12" PRIu64 " bytes => %12" PRIu64 " bytes             |\n", 
+                   (uint64_t)before*ClauseAllocator::Unit_Size, (uint64_t)ca.size()*ClauseAllocator::Unit_Size);
+        return;
+    }
+
     // Initialize the next region to a size corresponding to the estimated utilization degree. This
     // is not precise but should avoid some unnecessary reallocations for the new region:
     ClauseAllocator to(ca.size() - ca.wasted()); 
 
     cleanUpClauses();
     to.extra_clause_field = ca.extra_clause_field; // NOTE: this is important to keep (or lose) the extra fields.
+    to.clause_ids = ca.clause_ids;
     relocAll(to);
     Solver::relocAll(to);
     if (verbosity >= 2)
-        printf("|  Garbage collection:   %12d bytes => %12d bytes             |\n", 
-               ca.size()*ClauseAllocator::Unit_Size, to.size()*ClauseAllocator::Unit_Size);
+        printf("|  Garbage collection:   %12" PRIu64 " bytes => %12" PRIu64 " bytes             |\n", 
+               (uint64_t)ca.size()*ClauseAllocator::Unit_Size, (uint64_t)to.size()*ClauseAllocator::Unit_Size);
     to.moveTo(ca);
 }
+
+
+//=================================================================================================
+// Heuristic state across runs:
+//
+// The file is written in the byte order of the host:
+//   "GLST", version, nVars, number of frozen variables, number of learnts (uint32 each)
+//   the activities, divided by the largest one (one float per variable)
+//   the saved phases (one bit per variable)
+//   the frozen variables (uint32 each)
+//   the learnts: size, LBD, then the literals as 'toInt()' (uint32 each)
+// Variables are identified by their index only: on a different version of the formula, the
+// variables that do not exist any more are ignored, and the new ones keep their default state.
+
+static const char     state_magic[4] = { 'G', 'L', 'S', 'T' };
+static const uint32_t state_version  = 1;
+
+static inline bool writeU32(FILE* f, uint32_t x) { return fwrite(&x, sizeof(x), 1, f) == 1; }
+static inline bool readU32 (FILE* f, uint32_t& x) { return fread(&x, sizeof(x), 1, f) == 1; }
+
+struct LearntLBDLt {
+    ClauseAllocator& ca;
+    LearntLBDLt(ClauseAllocator& ca_) : ca(ca_) {}
+    bool operator () (CRef x, CRef y) const { return ca.lbd(ca[x]) < ca.lbd(ca[y]) || (ca.lbd(ca[x]) == ca.lbd(ca[y]) && ca[x].size() < ca[y].size()); }
+};
+
+
+/*_________________________________________________________________________________________________
+|
+|  saveState : (file : const char*) (max_learnts : int) (max_lbd : int)  ->  [bool]
+|  
+|  Description:
+|    Write the activities, saved phases and frozen variables to 'file', with the 'max_learnts'
+|    learnts of lowest LBD among those of LBD at most 'max_lbd'. Returns false if the file could not
+|    be written.
+|________________________________________________________________________________________________@*/
+bool SimpSolver::saveState(const char* file, int max_learnts, int max_lbd)
+{
+    FILE* f = fopen(file, "wb");
+    if (f == NULL) return false;
+
+    vec<Var> fr;
+    for (Var v = 0; v < nVars(); v++)
+        if (frozen[v]) fr.push(v);
+
+    vec<CRef> ls;
+    if (max_learnts > 0) {
+        for (int i = 0; i < learnts.size(); i++) {
+            const Clause& c = ca[learnts[i]];
+            if (!c.mark() && (int)ca.lbd(c) <= max_lbd && !satisfied(c))
+                ls.push(learnts[i]);
+        }
+        sort(ls, LearntLBDLt(ca));
+        if (ls.size() > max_learnts) ls.shrink(ls.size() - max_learnts);
+    }
+
+    bool ok = fwrite(state_magic, 1, 4, f) == 4 && writeU32(f, state_version) && writeU32(f, nVars())
+        && writeU32(f, fr.size()) && writeU32(f, ls.size());
+
+    double max_act = 0;
+    for (Var v = 0; v < nVars(); v++)
+        if (activity[v] > max_act) max_act = activity[v];
+    for (Var v = 0; ok && v < nVars(); v++) {
+        float a = max_act > 0 ? (float)(activity[v] / max_act) : 0;
+        ok = fwrite(&a, sizeof(a), 1, f) == 1;
+    }
+    for (Var v = 0; ok && v < nVars(); v += 8) {
+        unsigned char bits = 0;
+        for (int j = 0; j < 8 && v + j < nVars(); j++)
+            if (polarity[v + j]) bits |= 1 << j;
+        ok = fputc(bits, f) != EOF;
+    }
+    for (int i = 0; ok && i < fr.size(); i++)
+        ok = writeU32(f, fr[i]);
+    for (int i = 0; ok && i < ls.size(); i++) {
+        const Clause& c = ca[ls[i]];
+        ok = writeU32(f, c.size()) && writeU32(f, ca.lbd(c));
+        for (int j = 0; ok && j < c.size(); j++)
+            ok = writeU32(f, toInt(c[j]));
+    }
+
+    return (fclose(f) == 0) && ok;
+}
+
+
+/*_________________________________________________________________________________________________
+|
+|  loadState : (file : const char*)  ->  [bool]
+|  
+|  Description:
+|    Read a file written by 'saveState()' into the current variables. The activities are scaled by
+|    the current increment, so that the loaded order stands until the new conflicts override it.
+|    The learnts are kept aside until the next call to 'solve()' adds them, after simplification
+|    (the ones on eliminated variables are dropped). They are only implied by this formula if it
+|    contains the one of the saving run: do not save learnts for jobs whose clauses get removed.
+|    Returns false (the state being left unchanged) if the file is missing or malformed.
+|________________________________________________________________________________________________@*/
+bool SimpSolver::loadState(const char* file)
+{
+    FILE* f = fopen(file, "rb");
+    if (f == NULL) return false;
+
+    char     magic[4];
+    uint32_t version, n, nfrozen, nlearnts;
+    bool ok = fread(magic, 1, 4, f) == 4 && memcmp(magic, state_magic, 4) == 0
+        && readU32(f, version) && version == state_version
+        && readU32(f, n) && readU32(f, nfrozen) && readU32(f, nlearnts);
+
+    vec<float>         act;
+    vec<unsigned char> pol;
+    vec<uint32_t>      fr;
+    vec<Lit>           ls;
+    vec<int>           lbds;
+    if (ok) {
+        act.growTo(n); pol.growTo((n + 7) / 8); fr.growTo(nfrozen);
+        ok = fread((float*)act, sizeof(float), n, f) == n && fread((unsigned char*)pol, 1, pol.size(), f) == (size_t)pol.size()
+            && fread((uint32_t*)fr, sizeof(uint32_t), nfrozen, f) == nfrozen;
+    }
+    for (uint32_t i = 0; ok && i < nlearnts; i++) {
+        uint32_t size, lbd, x;
+        ok = readU32(f, size) && readU32(f, lbd);
+        for (uint32_t j = 0; ok && j < size; j++)
+            if ((ok = readU32(f, x))) ls.push(toLit(x));
+        ls.push(lit_Undef);
+        lbds.push(lbd);
+    }
+    fclose(f);
+    if (!ok) return false;
+
+    for (Var v = 0; v < nVars() && v < (Var)n; v++) {
+        activity[v] = act[v] * var_inc;
+        polarity[v] = (pol[v >> 3] >> (v & 7)) & 1;
+    }
+    for (int i = 0; i < fr.size(); i++)
+        if ((Var)fr[i] < nVars() && !isEliminated(fr[i]))
+            setFrozen(fr[i], true);
+    rebuildOrderHeap();
+
+    if (certifiedUNSAT) {
+        // The proof checker could not derive them:
+        if (verbosity >= 1 && lbds.size() > 0)
+            printf("c Learnts of the state file ignored (certified UNSAT)\n");
+        return true;
+    }
+    ls.copyTo(loaded_learnts);
+    lbds.copyTo(loaded_lbds);
+    return true;
+}
+
+
+// Add the learnts read by 'loadState()' at level 0. Returns false on a conflict.
+bool SimpSolver::addLoadedLearnts()
+{
+    assert(decisionLevel() == 0);
+    vec<Lit> lits;
+    int      c = 0, added = 0;
+    for (int i = 0; ok && i < loaded_learnts.size(); i++, c++) {
+        bool skip = false;
+        lits.clear();
+        for (; loaded_learnts[i] != lit_Undef; i++) {
+            Lit p = loaded_learnts[i];
+            if (var(p) >= nVars() || isEliminated(var(p)) || value(p) == l_True)
+                skip = true;
+            else if (value(p) == l_Undef)
+                lits.push(p);
+        }
+        if (skip) continue;
+        added++;
+        if (lits.size() == 0)
+            ok = false;
+        else if (lits.size() == 1)
+            uncheckedEnqueue(lits[0]);
+        else {
+            CRef cr = ca.alloc(lits, true);
+            ca.setLBD(ca[cr], loaded_lbds[c]);
+            ca[cr].setOneWatched(false);
+            unsigned int sz = 0;
+            for (int j = 0; j < lits.size(); j++)
+                if (!isSelector(var(lits[j]))) sz++;
+            ca[cr].setSizeWithoutSelectors(sz);
+            learnts.push(cr);
+            attachClause(cr);
+        }
+    }
+    if (ok && propagate() != CRef_Undef)
+        ok = false;
+
+    if (verbosity >= 1)
+        printf("c Learnts loaded from the state file: %d (of %d)\n", added, loaded_lbds.size());
+    loaded_learnts.clear(true);
+    loaded_lbds.clear(true);
+    return ok;
+}
@@ -0,0 +1,52 @@
+/root/repo/glucose-syrup/incremental/Main.o /root/repo/glucose-syrup/incremental/Main.or /root/repo/glucose-syrup/incremental/Main.od /root/repo/glucose-syrup/incremental/Main.op: /root/repo/glucose-syrup/incremental/Main.cc \
+ ../../solver_interface.h \
+ /root/repo/glucose-syrup/incremental/../utils/System.h \
+ /root/repo/glucose-syrup/incremental/../mtl/IntTypes.h \
+ /root/repo/glucose-syrup/incremental/../utils/ParseUtils.h \
+ /root/repo/glucose-syrup/incremental/../utils/Options.h \
+ /root/repo/glucose-syrup/incremental/../mtl/Vec.h \
+ /root/repo/glucose-syrup/incremental/../mtl/XAlloc.h \
+ /root/repo/glucose-syrup/incremental/../core/Dimacs.h \
+ /root/repo/glucose-syrup/incremental/../core/SolverTypes.h \
+ /root/repo/glucose-syrup/incremental/../mtl/Alg.h \
+ /root/repo/glucose-syrup/incremental/../mtl/Map.h \
+ /root/repo/glucose-syrup/incremental/../mtl/Alloc.h \
+ /root/repo/glucose-syrup/incremental/../mtl/Sort.h \
+ /root/repo/glucose-syrup/incremental/../core/Constants.h \
+ /root/repo/glucose-syrup/incremental/../simp/SimpSolver.h \
+ /root/repo/glucose-syrup/incremental/../mtl/Queue.h \
+ /root/repo/glucose-syrup/incremental/../core/Solver.h \
+ /root/repo/glucose-syrup/incremental/../mtl/Heap.h \
+ /root/repo/glucose-syrup/incremental/../core/BoundedQueue.h \
+ /root/repo/glucose-syrup/incremental/../core/DratWriter.h \
+ /root/repo/glucose-syrup/incremental/../core/DimacsWriter.h \
+ /root/repo/glucose-syrup/incremental/../core/VMTFQueue.h \
+ /root/repo/glucose-syrup/incremental/../core/LocalSearch.h \
+ /root/repo/glucose-syrup/incremental/../core/PhaseTimers.h \
+ /root/repo/glucose-syrup/incremental/../core/ExternalPropagator.h \
+ /root/repo/glucose-syrup/incremental/../mtl/Clone.h
+/root/repo/glucose-syrup/incremental/SimpSolver.o /root/repo/glucose-syrup/incremental/SimpSolver.or /root/repo/glucose-syrup/incremental/SimpSolver.od /root/repo/glucose-syrup/incremental/SimpSolver.op: /root/repo/glucose-syrup/incremental/SimpSolver.cc \
+ /root/repo/glucose-syrup/incremental/../mtl/Sort.h \
+ /root/repo/glucose-syrup/incremental/../mtl/Vec.h \
+ /root/repo/glucose-syrup/incremental/../mtl/IntTypes.h \
+ /root/repo/glucose-syrup/incremental/../mtl/XAlloc.h \
+ /root/repo/glucose-syrup/incremental/../simp/SimpSolver.h \
+ /root/repo/glucose-syrup/incremental/../mtl/Queue.h \
+ /root/repo/glucose-syrup/incremental/../core/Solver.h \
+ /root/repo/glucose-syrup/incremental/../mtl/Heap.h \
+ /root/repo/glucose-syrup/incremental/../mtl/Alg.h \
+ /root/repo/glucose-syrup/incremental/../utils/Options.h \
+ /root/repo/glucose-syrup/incremental/../utils/ParseUtils.h \
+ /root/repo/glucose-syrup/incremental/../core/SolverTypes.h \
+ /root/repo/glucose-syrup/incremental/../mtl/Map.h \
+ /root/repo/glucose-syrup/incremental/../mtl/Alloc.h \
+ /root/repo/glucose-syrup/incremental/../core/Constants.h \
+ /root/repo/glucose-syrup/incremental/../core/BoundedQueue.h \
+ /root/repo/glucose-syrup/incremental/../core/DratWriter.h \
+ /root/repo/glucose-syrup/incremental/../core/DimacsWriter.h \
+ /root/repo/glucose-syrup/incremental/../core/VMTFQueue.h \
+ /root/repo/glucose-syrup/incremental/../core/LocalSearch.h \
+ /root/repo/glucose-syrup/incremental/../core/PhaseTimers.h \
+ /root/repo/glucose-syrup/incremental/../core/ExternalPropagator.h \
+ /root/repo/glucose-syrup/incremental/../mtl/Clone.h \
+ /root/repo/glucose-syrup/incremental/../utils/System.h
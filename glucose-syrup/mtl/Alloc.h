@@ -28,50 +28,73 @@ namespace Glucose {
 
 //=================================================================================================
 // Simple Region-based memory allocator:
+//
+// References are 32 bits wide, which limits a region to 2^32 elements. Building with
+// REGION_REF_SHIFT=k (e.g. -D REGION_REF_SHIFT=2) makes a reference designate a block of 2^k
+// elements instead: references (and thus watchers and reasons) keep their size while the region
+// can grow up to 2^(32+k) elements. Each allocation is then rounded up to a whole number of blocks.
+
+#ifndef REGION_REF_SHIFT
+#define REGION_REF_SHIFT 0
+#endif
 
 template<class T>
 class RegionAllocator
 {
+ public:
+#if REGION_REF_SHIFT > 0
+    typedef uint64_t Size;
+#else
+    typedef uint32_t Size;
+#endif
+
+ private:
     T*        memory;
-    uint32_t  sz;
-    uint32_t  cap;
-    uint32_t  wasted_;
+    bool      mapped;       // Memory comes from mmap (see xregion())
+    Size      sz;
+    Size      cap;
+    Size      wasted_;
 
-    void capacity(uint32_t min_cap);
+    void capacity(Size min_cap);
 
  public:
     // TODO: make this a class for better type-checking?
     typedef uint32_t Ref;
     enum { Ref_Undef = UINT32_MAX };
+    enum { Ref_Reserved = 3 };   // References just below 'Ref_Undef' never given out (sentinels of the users)
     enum { Unit_Size = sizeof(uint32_t) };
+    enum { Ref_Shift = REGION_REF_SHIFT, Block_Size = 1 << REGION_REF_SHIFT };
 
-    explicit RegionAllocator(uint32_t start_cap = 1024*1024) : memory(NULL), sz(0), cap(0), wasted_(0){ capacity(start_cap); }
+    static Size blocks(int size) { return ((Size)size + Block_Size - 1) & ~(Size)(Block_Size - 1); }
+
+    explicit RegionAllocator(Size start_cap = 1024*1024) : memory(NULL), mapped(false), sz(0), cap(0), wasted_(0){ capacity(start_cap); }
     ~RegionAllocator()
     {
         if (memory != NULL)
-            ::free(memory);
+            xregionFree(memory, sizeof(T)*cap, mapped);
     }
 
 
-    uint32_t size      () const      { return sz; }
-    uint32_t getCap    () const      { return cap;}
-    uint32_t wasted    () const      { return wasted_; }
+    Size     size      () const      { return sz; }
+    Size     getCap    () const      { return cap;}
+    Size     wasted    () const      { return wasted_; }
 
     Ref      alloc     (int size); 
-    void     free      (int size)    { wasted_ += size; }
+    void     free      (int size)    { wasted_ += blocks(size); }
 
     // Deref, Load Effective Address (LEA), Inverse of LEA (AEL):
-    T&       operator[](Ref r)       { assert(r >= 0 && r < sz); return memory[r]; }
-    const T& operator[](Ref r) const { assert(r >= 0 && r < sz); return memory[r]; }
+    T&       operator[](Ref r)       { assert(((Size)r << Ref_Shift) < sz); return memory[(Size)r << Ref_Shift]; }
+    const T& operator[](Ref r) const { assert(((Size)r << Ref_Shift) < sz); return memory[(Size)r << Ref_Shift]; }
 
-    T*       lea       (Ref r)       { assert(r >= 0 && r < sz); return &memory[r]; }
-    const T* lea       (Ref r) const { assert(r >= 0 && r < sz); return &memory[r]; }
+    T*       lea       (Ref r)       { assert(((Size)r << Ref_Shift) < sz); return &memory[(Size)r << Ref_Shift]; }
+    const T* lea       (Ref r) const { assert(((Size)r << Ref_Shift) < sz); return &memory[(Size)r << Ref_Shift]; }
     Ref      ael       (const T* t)  { assert((void*)t >= (void*)&memory[0] && (void*)t < (void*)&memory[sz-1]);
-        return  (Ref)(t - &memory[0]); }
+        return  (Ref)((t - &memory[0]) >> Ref_Shift); }
 
     void     moveTo(RegionAllocator& to) {
-        if (to.memory != NULL) ::free(to.memory);
+        if (to.memory != NULL) xregionFree(to.memory, sizeof(T)*to.cap, to.mapped);
         to.memory = memory;
+        to.mapped = mapped;
         to.sz = sz;
         to.cap = cap;
         to.wasted_ = wasted_;
@@ -80,9 +103,19 @@ class RegionAllocator
         sz = cap = wasted_ = 0;
     }
 
+    // The live data has been slid down to the first 'new_sz' elements: everything above is free
+    // (optionally, its physical pages are released):
+    void     compacted (Size new_sz, bool release_memory) {
+        assert(new_sz <= sz);
+        sz      = new_sz;
+        wasted_ = 0;
+        if (release_memory)
+            xdiscard(memory + sz, sizeof(T)*(cap - sz));
+    }
+
     void copyTo(RegionAllocator& to) const {
      //   if (to.memory != NULL) ::free(to.memory);
-        to.memory = (T*)xrealloc(to.memory, sizeof(T)*cap);
+        to.memory = (T*)xregion(to.memory, sizeof(T)*to.cap, sizeof(T)*cap, to.mapped);
         memcpy(to.memory,memory,sizeof(T)*cap);        
         to.sz = sz;
         to.cap = cap;
@@ -94,26 +127,28 @@ class RegionAllocator
 };
 
 template<class T>
-void RegionAllocator<T>::capacity(uint32_t min_cap)
+void RegionAllocator<T>::capacity(Size min_cap)
 {
     if (cap >= min_cap) return;
 
-    uint32_t prev_cap = cap;
+    // Largest capacity whose blocks can all be referenced (Ref_Undef and the reserved refs excluded):
+    const Size max_cap = (Size)(Ref_Undef - Ref_Reserved) << Ref_Shift;
+    Size       prev_cap = cap;
     while (cap < min_cap){
         // NOTE: Multiply by a factor (13/8) without causing overflow, then add 2 and make the
         // result even by clearing the least significant bit. The resulting sequence of capacities
         // is carefully chosen to hit a maximum capacity that is close to the '2^32-1' limit when
         // using 'uint32_t' as indices so that as much as possible of this space can be used.
-        uint32_t delta = ((cap >> 1) + (cap >> 3) + 2) & ~1;
-        cap += delta;
+        Size delta = ((cap >> 1) + (cap >> 3) + 2) & ~1;
 
-        if (cap <= prev_cap)
+        if (cap == max_cap || cap + delta <= cap)
             throw OutOfMemoryException();
+        cap = (cap + delta > max_cap) ? max_cap : cap + delta;
     }
     //printf(" .. (%p) cap = %u\n", this, cap);
 
     assert(cap > 0);
-    memory = (T*)xrealloc(memory, sizeof(T)*cap);
+    memory = (T*)xregion(memory, sizeof(T)*prev_cap, sizeof(T)*cap, mapped);
 }
 
 
@@ -123,16 +158,18 @@ RegionAllocator<T>::alloc(int size)
 { 
     //printf("ALLOC called (this = %p, size = %d)\n", this, size); fflush(stdout);
     assert(size > 0);
-    capacity(sz + size);
+    Size units = blocks(size);
+    capacity(sz + units);
 
-    uint32_t prev_sz = sz;
-    sz += size;
+    Size prev_sz = sz;
+    sz += units;
     
     // Handle overflow:
     if (sz < prev_sz)
         throw OutOfMemoryException();
 
-    return prev_sz;
+    assert((prev_sz >> Ref_Shift) < (Size)(Ref_Undef - Ref_Reserved));
+    return (Ref)(prev_sz >> Ref_Shift);
 }
 
 
@@ -24,6 +24,12 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include <errno.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 namespace Glucose {
 
@@ -41,6 +47,104 @@ static inline void* xrealloc(void *ptr, size_t size)
 	}
 }
 
+// Give back to the system the physical pages lying entirely inside [ptr, ptr+size). The memory stays
+// allocated and reads as zero the next time it is touched (no-op where madvise is not available):
+static inline void xdiscard(void *ptr, size_t size)
+{
+#if defined(__linux__)
+    uintptr_t page  = (uintptr_t)sysconf(_SC_PAGESIZE);
+    uintptr_t begin = ((uintptr_t)ptr + page - 1) & ~(page - 1);
+    uintptr_t end   = ((uintptr_t)ptr + size) & ~(page - 1);
+    if (end > begin)
+        madvise((void*)begin, end - begin, MADV_DONTNEED);
+#else
+    (void)ptr; (void)size;
+#endif
+}
+
+//=================================================================================================
+// Allocation policy for large regions (see RegionAllocator), set once at startup for the process:
+//
+//   huge_pages = 0: plain malloc/realloc,
+//                1: anonymous mappings aligned on huge pages and advised for transparent huge pages,
+//                2: explicit huge pages (MAP_HUGETLB), or 1 when the system has none reserved.
+//   prefault   : touch the pages of a region as soon as it grows, instead of taking the page faults
+//                later (during propagation).
+
+struct XAllocPolicy {
+    int  huge_pages;
+    bool prefault;
+};
+
+inline XAllocPolicy& xallocPolicy() { static XAllocPolicy policy = { 0, false }; return policy; }
+
+#if defined(__linux__)
+static const size_t XAlloc_Huge_Page = (size_t)2 << 20;
+
+static inline size_t xmapSize(size_t size) { return (size + XAlloc_Huge_Page - 1) & ~(XAlloc_Huge_Page - 1); }
+
+static inline void* xmap(size_t size, int huge_pages)
+{
+    size_t len = xmapSize(size);
+    void*  mem = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    if (huge_pages == 2)
+        mem = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+#endif
+    if (mem == MAP_FAILED){
+        // Map one more huge page than needed and trim it, so that the region starts on a boundary:
+        char* raw = (char*)mmap(NULL, len + XAlloc_Huge_Page, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (raw == MAP_FAILED)
+            throw OutOfMemoryException();
+        char* aligned = (char*)(((uintptr_t)raw + XAlloc_Huge_Page - 1) & ~(uintptr_t)(XAlloc_Huge_Page - 1));
+        if (aligned > raw)
+            munmap(raw, aligned - raw);
+        if (raw + XAlloc_Huge_Page > aligned)
+            munmap(aligned + len, raw + XAlloc_Huge_Page - aligned);
+        mem = aligned;
+#ifdef MADV_HUGEPAGE
+        if (huge_pages > 0)
+            madvise(mem, len, MADV_HUGEPAGE);
+#endif
+    }
+    return mem;
+}
+#endif
+
+static inline void xregionFree(void *ptr, size_t size, bool mapped)
+{
+#if defined(__linux__)
+    if (mapped){
+        munmap(ptr, xmapSize(size));
+        return; }
+#endif
+    (void)size; (void)mapped;
+    free(ptr);
+}
+
+// Resize a region of 'old_size' bytes following the allocation policy. 'mapped' tells whether the
+// memory comes from mmap rather than malloc (a mapped region stays mapped), and is updated:
+static inline void* xregion(void *ptr, size_t old_size, size_t new_size, bool& mapped)
+{
+    const XAllocPolicy& policy = xallocPolicy();
+    void* mem;
+#if defined(__linux__)
+    if (mapped || policy.huge_pages > 0){
+        mem = xmap(new_size, policy.huge_pages);
+        if (ptr != NULL){
+            memcpy(mem, ptr, old_size < new_size ? old_size : new_size);
+            xregionFree(ptr, old_size, mapped); }
+        mapped = true;
+    }else
+#endif
+        mem = xrealloc(ptr, new_size);
+
+    if (policy.prefault && mem != NULL)
+        for (size_t i = old_size; i < new_size; i += 4096)
+            ((volatile char*)mem)[i] = 0;
+    return mem;
+}
+
 //=================================================================================================
 }
 
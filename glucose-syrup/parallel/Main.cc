@@ -109,6 +109,7 @@ int main(int argc, char** argv)
         IntOption    vv  ("MAIN", "vv",   "Verbosity every vv conflicts", 10000, IntRange(1,INT32_MAX));
         IntOption    cpu_lim("MAIN", "cpu-lim","Limit on CPU time allowed in seconds.\n", INT32_MAX, IntRange(0, INT32_MAX));
         IntOption    mem_lim("MAIN", "mem-lim","Limit on memory usage in megabytes.\n", INT32_MAX, IntRange(0, INT32_MAX));
+        StringOption stats_json("MAIN", "stats-json", "If given, append the statistics of each solve call to this file (one line of JSON).");
         
         parseOptions(argc, argv, true);
 
@@ -202,6 +203,11 @@ int main(int argc, char** argv)
 
       //  vec<Lit> dummy;
         lbool ret = msolver.solve();
+        if (stats_json) {
+            FILE* stats = fopen(stats_json, "a");
+            if (stats != NULL) msolver.printStatsJSON(stats, 1, ret), fclose(stats);
+            else printf("c WARNING! Could not open the statistics file: %s\n", (const char*)stats_json);
+        }
 	
 	
         printf("c\n");
@@ -235,6 +235,18 @@ bool MultiSolvers::addClause_(vec<Lit>&ps) {
 }
 
 
+bool MultiSolvers::addAtMost_(vec<Lit>& ps, int k) {
+  assert(solvers[0] != NULL); // There is at least one solver.
+  if (!okay())  return false;
+
+  // At the beginning only solver 0 load the formula (the clones copy its constraints)
+  int n = allClonesAreBuilt ? nbsolvers : 1;
+  for(int i=0;i<n;i++)
+    solvers[i]->addAtMost(ps, k);
+  return ok = solvers[0]->okay();
+}
+
+
 bool MultiSolvers::simplify() {
   assert(solvers[0] != NULL); // There is at least one solver.
 
@@ -409,6 +421,25 @@ void MultiSolvers::printFinalStats() {
     }
     printf("|                 |\n"); 
 
+#ifdef PROFILE_PHASES
+    printf("c |---------------");
+    for(int i = 0;i<solvers.size();i++) 
+        printf("|------------");
+    printf("|-----------------|\n");    
+    printf("c | Time (s) in   ");
+    for(int i = 0;i<solvers.size();i++) 
+        printf("|            ");
+    printf("|                 |\n");    
+    for(int k = 0;k < nb_phases;k++) {
+        printf("c | %-14s", PhaseTimers::name(k));
+        double total = 0;
+        for(int i=0;i<solvers.size();i++) {
+            printf("| %10.2f ", solvers[i]->phaseTimers.seconds(k));
+            total += solvers[i]->phaseTimers.seconds(k);
+        }
+        printf("| %15.2f |\n", total);
+    }
+#endif
 
     int winner = -1;
    for(int i=0;i<solvers.size();i++) {
@@ -444,6 +475,30 @@ int sum = 0;
 
 }
 
+void MultiSolvers::printStatsJSON(FILE* out, int call, lbool result) {
+    uint64_t conflicts = 0, decisions = 0, propagations = 0, restarts = 0, exported = 0, imported = 0;
+    PhaseTimers timers;
+    for(int i = 0;i < solvers.size();i++) {
+        conflicts += solvers[i]->conflicts;
+        decisions += solvers[i]->decisions;
+        propagations += solvers[i]->propagations;
+        restarts += solvers[i]->starts;
+        exported += solvers[i]->nbexported;
+        imported += solvers[i]->nbimported;
+        timers.add(solvers[i]->phaseTimers);
+    }
+    fprintf(out, "{\"schema\": 1, \"solver\": \"glucose-syrup\", \"event\": \"solve\", \"call\": %d, \"result\": \"%s\", ",
+            call, result == l_True ? "SAT" : result == l_False ? "UNSAT" : "UNKNOWN");
+    fprintf(out, "\"counters\": {\"conflicts\": %" PRIu64", \"decisions\": %" PRIu64", \"propagations\": %" PRIu64", \"restarts\": %" PRIu64", ",
+            conflicts, decisions, propagations, restarts);
+    fprintf(out, "\"vars\": %d, \"clauses\": %d, \"threads\": %d, \"exported\": %" PRIu64", \"imported\": %" PRIu64"}, ",
+            nVars(), nClauses(), solvers.size(), exported, imported);
+    fprintf(out, "\"timings\": {\"cpu\": %.3f, \"phases\": ", cpuTime());
+    timers.printJSON(out);
+    fprintf(out, "}, \"memory\": {\"mb\": %.1f, \"peak_mb\": %.1f}}\n", memUsed(), memUsedPeak());
+    fflush(out);
+}
+
 // Well, all those parameteres are just naive guesses... No experimental evidences for this.
 void MultiSolvers::adjustParameters() {
     SolverConfiguration::configure(this,nbsolvers);
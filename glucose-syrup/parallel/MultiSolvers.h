@@ -64,6 +64,7 @@ public:
   ~MultiSolvers();
  
   void printFinalStats(); 
+  void printStatsJSON(FILE* out, int call, lbool result); // Same schema as Solver::printStatsJSON(), summed over the threads
 
   void setVerbosity(int i);
   int verbosity();
@@ -75,6 +76,7 @@ public:
   Var     newVar    (bool polarity = true, bool dvar = true); // Add a new variable with parameters specifying variable mode.
   bool    addClause (const vec<Lit>& ps);                           // Add a clause to the solver. NOTE! 'ps' may be shrunk by this method!
   bool    addClause_(      vec<Lit>& ps);       
+  bool    addAtMost_(      vec<Lit>& ps, int k);   // Add the constraint: at most 'k' literals of 'ps' are true.
   
   bool    simplify     ();                        // Removes already satisfied clauses.
   
@@ -129,11 +129,11 @@ struct reduceDB_oneWatched_lt {
         if (ca[x].size() > ca[y].size()) return 1;
         if (ca[x].size() < ca[y].size()) return 0;
 
-        if (ca[x].lbd() > ca[y].lbd()) return 1;
-        if (ca[x].lbd() < ca[y].lbd()) return 0;
+        if (ca.lbd(ca[x]) > ca.lbd(ca[y])) return 1;
+        if (ca.lbd(ca[x]) < ca.lbd(ca[y])) return 0;
 
         // Finally we can use old activity or size, we choose the last one
-        return ca[x].activity() < ca[y].activity();
+        return ca.activity(ca[x]) < ca.activity(ca[y]);
         //return x->size() < y->size();
 
         //return ca[x].size() > 2 && (ca[y].size() == 2 || ca[x].activity() < ca[y].activity()); } 
@@ -142,18 +142,23 @@ struct reduceDB_oneWatched_lt {
 
 // @overide
 void ParallelSolver::reduceDB() {
+    TIME_PHASE(phaseTimers, phase_reduceDB);
 
     int i, j;
     nbReduceDB++;
+#ifdef LEARNTS_METADATA_TABLE
+    ca.sortLearnts(learnts, false);
+#else
     sort(learnts, reduceDB_lt(ca));
+#endif
 
     int limit;
 
     if (!panicModeIsEnabled()) {
         // We have a lot of "good" clauses, it is difficult to compare them. Keep more !
-        if (ca[learnts[learnts.size() / RATIOREMOVECLAUSES]].lbd() <= 3) nbclausesbeforereduce += specialIncReduceDB;
+        if (ca.lbd(ca[learnts[learnts.size() / RATIOREMOVECLAUSES]]) <= 3) nbclausesbeforereduce += specialIncReduceDB;
         // Useless :-)
-        if (ca[learnts.last()].lbd() <= 5) nbclausesbeforereduce += specialIncReduceDB;
+        if (ca.lbd(ca[learnts.last()]) <= 5) nbclausesbeforereduce += specialIncReduceDB;
 
         // Don't delete binary or locked clauses. From the rest, delete clauses from the first half
         // Keep clauses which seem to be usefull (their lbd was reduce during this sequence)
@@ -169,15 +174,15 @@ void ParallelSolver::reduceDB() {
 
         Clause& c = ca[learnts[i]];
         if (i == learnts.size() / 2)
-            goodlimitlbd = c.lbd();
+            goodlimitlbd = ca.lbd(c);
         sumsize += c.size();
-        if (c.lbd() > 2 && c.size() > 2 && c.canBeDel() && !locked(c) && (i < limit)) {
+        if (ca.lbd(c) > 2 && c.size() > 2 && ca.canBeDel(c) && !locked(c) && (i < limit)) {
             removeClause(learnts[i]);
             nbRemovedClauses++;
             panicModeLastRemoved++;
         } else {
-            if (!c.canBeDel()) limit++; //we keep c, so we can delete an other clause
-            c.setCanBeDel(true); // At the next step, c can be delete
+            if (!ca.canBeDel(c)) limit++; //we keep c, so we can delete an other clause
+            ca.setCanBeDel(c, true); // At the next step, c can be delete
             learnts[j++] = learnts[i];
         }
     }
@@ -198,13 +203,13 @@ void ParallelSolver::reduceDB() {
 
         for (i = j = 0; i < unaryWatchedClauses.size(); i++) {
             Clause& c = ca[unaryWatchedClauses[i]];
-            if (c.lbd() > 2 && c.size() > 2 && c.canBeDel() && !locked(c) && (i < limit)) {
+            if (ca.lbd(c) > 2 && c.size() > 2 && ca.canBeDel(c) && !locked(c) && (i < limit)) {
                 removeClause(unaryWatchedClauses[i], c.getOneWatched()); // remove from the purgatory (or not)
                 nbRemovedUnaryWatchedClauses++;
                 panicModeLastRemovedShared++;
             } else {
-                if (!c.canBeDel()) limit++; //we keep c, so we can delete an other clause
-                c.setCanBeDel(true); // At the next step, c can be delete
+                if (!ca.canBeDel(c)) limit++; //we keep c, so we can delete an other clause
+                ca.setCanBeDel(c, true); // At the next step, c can be delete
                 unaryWatchedClauses[j++] = unaryWatchedClauses[i];
             }
         }
@@ -227,13 +232,13 @@ void ParallelSolver::reduceDB() {
 
 
 void ParallelSolver::parallelImportClauseDuringConflictAnalysis(Clause &c,CRef confl) {
-    if (dontExportDirectReusedClauses && (confl == lastLearntClause) && (c.getExported() < 2)) { // Experimental stuff
-        c.setExported(2);
+    if (dontExportDirectReusedClauses && (confl == lastLearntClause) && (ca.getExported(c) < 2)) { // Experimental stuff
+        ca.setExported(c, 2);
         nbNotExportedBecauseDirectlyReused++;
-    } else if (shareAfterProbation && c.getExported() != 2 && conflicts > firstSharing) {
-        c.setExported(c.getExported() + 1);
-        if (!c.wasImported() && c.getExported() == 2) { // It's a new interesting clause: 
-            if (c.lbd() == 2 || (c.size() < goodlimitsize && c.lbd() <= goodlimitlbd)) {
+    } else if (shareAfterProbation && ca.getExported(c) != 2 && conflicts > firstSharing) {
+        ca.setExported(c, ca.getExported(c) + 1);
+        if (!c.wasImported() && ca.getExported(c) == 2) { // It's a new interesting clause: 
+            if (ca.lbd(c) == 2 || (c.size() < goodlimitsize && ca.lbd(c) <= goodlimitlbd)) {
                 shareClause(c);
             }
         }
@@ -276,6 +281,7 @@ void ParallelSolver::reportProgressArrayImports(vec<unsigned int> &totalColumns)
 |________________________________________________________________________________________________@*/
 
 bool ParallelSolver::shareClause(Clause & c) {
+    TIME_PHASE(phaseTimers, phase_export);
     bool sent = sharedcomp->addLearnt(this, c);
     if (sent)
         nbexported++;
@@ -303,6 +309,7 @@ bool ParallelSolver::panicModeIsEnabled() {
 |________________________________________________________________________________________________@*/
 
 void ParallelSolver::parallelImportUnaryClauses() {
+    TIME_PHASE(phaseTimers, phase_import);
     Lit l;
     while ((l = sharedcomp->getUnary(this)) != lit_Undef) {
         if (value(var(l)) == l_Undef) {
@@ -324,6 +331,7 @@ void ParallelSolver::parallelImportUnaryClauses() {
 bool ParallelSolver::parallelImportClauses() {
 
     assert(decisionLevel() == 0);
+    TIME_PHASE(phaseTimers, phase_import);
     int importedFromThread;
     while (sharedcomp->getNewClause(this, importedFromThread, importedClause)) {
         assert(importedFromThread <= sharedcomp->nbThreads);
@@ -336,11 +344,11 @@ bool ParallelSolver::parallelImportClauses() {
 
         //printf("Thread %d imports clause from thread %d\n", threadNumber(), importedFromThread);
         CRef cr = ca.alloc(importedClause, true, true);
-        ca[cr].setLBD(importedClause.size());
+        ca.setLBD(ca[cr], importedClause.size());
         if (plingeling) // 0 means a broadcasted clause (good clause), 1 means a survivor clause, broadcasted
-            ca[cr].setExported(2); // A broadcasted clause (or a survivor clause) do not share it anymore
+            ca.setExported(ca[cr], 2); // A broadcasted clause (or a survivor clause) do not share it anymore
         else {
-            ca[cr].setExported(1); // next time we see it in analyze, we share it (follow route / broadcast depending on the global strategy, part of an ongoing experimental stuff: a clause in one Watched will be set to exported 2 when promotted.
+            ca.setExported(ca[cr], 1); // next time we see it in analyze, we share it (follow route / broadcast depending on the global strategy, part of an ongoing experimental stuff: a clause in one Watched will be set to exported 2 when promotted.
         }
         ca[cr].setImportedFrom(importedFromThread);
         unaryWatchedClauses.push(cr);
@@ -369,6 +377,7 @@ bool ParallelSolver::parallelImportClauses() {
 |________________________________________________________________________________________________@*/
 
 void ParallelSolver::parallelExportUnaryClause(Lit p) {
+    TIME_PHASE(phaseTimers, phase_export);
     // Multithread
     sharedcomp->addLearnt(this,p ); // TODO: there can be a contradiction here (two theads proving a and -a)
     nbexportedunit++;
@@ -389,10 +398,10 @@ void ParallelSolver::parallelExportClauseDuringSearch(Clause &c) {
     //
     // Multithread
     // Now I'm sharing the clause if seen in at least two conflicts analysis shareClause(ca[cr]);
-    if ((plingeling && !shareAfterProbation && c.lbd() < 8 && c.size() < 40) ||
-            (c.lbd() <= 2)) { // For this class of clauses, I'm sharing them asap (they are Glue CLauses, no probation for them)
+    if ((plingeling && !shareAfterProbation && ca.lbd(c) < 8 && c.size() < 40) ||
+            (ca.lbd(c) <= 2)) { // For this class of clauses, I'm sharing them asap (they are Glue CLauses, no probation for them)
         shareClause(c);
-        c.setExported(2);
+        ca.setExported(c, 2);
     }
 
 }
@@ -0,0 +1,228 @@
+/root/repo/glucose-syrup/parallel/ClausesBuffer.o /root/repo/glucose-syrup/parallel/ClausesBuffer.or /root/repo/glucose-syrup/parallel/ClausesBuffer.od /root/repo/glucose-syrup/parallel/ClausesBuffer.op: /root/repo/glucose-syrup/parallel/ClausesBuffer.cc \
+ /root/repo/glucose-syrup/parallel/../parallel/ClausesBuffer.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Vec.h \
+ /root/repo/glucose-syrup/parallel/../mtl/IntTypes.h \
+ /root/repo/glucose-syrup/parallel/../mtl/XAlloc.h \
+ /root/repo/glucose-syrup/parallel/../core/SolverTypes.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Alg.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Map.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Alloc.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Sort.h \
+ /root/repo/glucose-syrup/parallel/../core/Constants.h \
+ /root/repo/glucose-syrup/parallel/../core/Solver.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Heap.h \
+ /root/repo/glucose-syrup/parallel/../utils/Options.h \
+ /root/repo/glucose-syrup/parallel/../utils/ParseUtils.h \
+ /root/repo/glucose-syrup/parallel/../core/BoundedQueue.h \
+ /root/repo/glucose-syrup/parallel/../core/DratWriter.h \
+ /root/repo/glucose-syrup/parallel/../core/DimacsWriter.h \
+ /root/repo/glucose-syrup/parallel/../core/VMTFQueue.h \
+ /root/repo/glucose-syrup/parallel/../core/LocalSearch.h \
+ /root/repo/glucose-syrup/parallel/../core/PhaseTimers.h \
+ /root/repo/glucose-syrup/parallel/../core/ExternalPropagator.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Clone.h
+/root/repo/glucose-syrup/parallel/Main.o /root/repo/glucose-syrup/parallel/Main.or /root/repo/glucose-syrup/parallel/Main.od /root/repo/glucose-syrup/parallel/Main.op: /root/repo/glucose-syrup/parallel/Main.cc \
+ /root/repo/glucose-syrup/parallel/../utils/System.h \
+ /root/repo/glucose-syrup/parallel/../mtl/IntTypes.h \
+ /root/repo/glucose-syrup/parallel/../utils/ParseUtils.h \
+ /root/repo/glucose-syrup/parallel/../utils/Options.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Vec.h \
+ /root/repo/glucose-syrup/parallel/../mtl/XAlloc.h \
+ /root/repo/glucose-syrup/parallel/../core/Dimacs.h \
+ /root/repo/glucose-syrup/parallel/../core/SolverTypes.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Alg.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Map.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Alloc.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Sort.h \
+ /root/repo/glucose-syrup/parallel/../core/Constants.h \
+ /root/repo/glucose-syrup/parallel/../simp/SimpSolver.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Queue.h \
+ /root/repo/glucose-syrup/parallel/../core/Solver.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Heap.h \
+ /root/repo/glucose-syrup/parallel/../core/BoundedQueue.h \
+ /root/repo/glucose-syrup/parallel/../core/DratWriter.h \
+ /root/repo/glucose-syrup/parallel/../core/DimacsWriter.h \
+ /root/repo/glucose-syrup/parallel/../core/VMTFQueue.h \
+ /root/repo/glucose-syrup/parallel/../core/LocalSearch.h \
+ /root/repo/glucose-syrup/parallel/../core/PhaseTimers.h \
+ /root/repo/glucose-syrup/parallel/../core/ExternalPropagator.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Clone.h \
+ /root/repo/glucose-syrup/parallel/../parallel/ParallelSolver.h \
+ /root/repo/glucose-syrup/parallel/../parallel/SharedCompanion.h \
+ /root/repo/glucose-syrup/parallel/../parallel/SolverCompanion.h \
+ /root/repo/glucose-syrup/parallel/../parallel/ClausesBuffer.h \
+ /root/repo/glucose-syrup/parallel/../parallel/MultiSolvers.h
+/root/repo/glucose-syrup/parallel/MultiSolvers.o /root/repo/glucose-syrup/parallel/MultiSolvers.or /root/repo/glucose-syrup/parallel/MultiSolvers.od /root/repo/glucose-syrup/parallel/MultiSolvers.op: /root/repo/glucose-syrup/parallel/MultiSolvers.cc \
+ /root/repo/glucose-syrup/parallel/../parallel/MultiSolvers.h \
+ /root/repo/glucose-syrup/parallel/../parallel/ParallelSolver.h \
+ /root/repo/glucose-syrup/parallel/../core/SolverTypes.h \
+ /root/repo/glucose-syrup/parallel/../mtl/IntTypes.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Alg.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Vec.h \
+ /root/repo/glucose-syrup/parallel/../mtl/XAlloc.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Map.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Alloc.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Sort.h \
+ /root/repo/glucose-syrup/parallel/../core/Constants.h \
+ /root/repo/glucose-syrup/parallel/../core/Solver.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Heap.h \
+ /root/repo/glucose-syrup/parallel/../utils/Options.h \
+ /root/repo/glucose-syrup/parallel/../utils/ParseUtils.h \
+ /root/repo/glucose-syrup/parallel/../core/BoundedQueue.h \
+ /root/repo/glucose-syrup/parallel/../core/DratWriter.h \
+ /root/repo/glucose-syrup/parallel/../core/DimacsWriter.h \
+ /root/repo/glucose-syrup/parallel/../core/VMTFQueue.h \
+ /root/repo/glucose-syrup/parallel/../core/LocalSearch.h \
+ /root/repo/glucose-syrup/parallel/../core/PhaseTimers.h \
+ /root/repo/glucose-syrup/parallel/../core/ExternalPropagator.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Clone.h \
+ /root/repo/glucose-syrup/parallel/../simp/SimpSolver.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Queue.h \
+ /root/repo/glucose-syrup/parallel/../parallel/SharedCompanion.h \
+ /root/repo/glucose-syrup/parallel/../parallel/SolverCompanion.h \
+ /root/repo/glucose-syrup/parallel/../parallel/ClausesBuffer.h \
+ /root/repo/glucose-syrup/parallel/../utils/System.h \
+ /root/repo/glucose-syrup/parallel/../parallel/SolverConfiguration.h
+/root/repo/glucose-syrup/parallel/ParallelSolver.o /root/repo/glucose-syrup/parallel/ParallelSolver.or /root/repo/glucose-syrup/parallel/ParallelSolver.od /root/repo/glucose-syrup/parallel/ParallelSolver.op: /root/repo/glucose-syrup/parallel/ParallelSolver.cc \
+ /root/repo/glucose-syrup/parallel/../parallel/ParallelSolver.h \
+ /root/repo/glucose-syrup/parallel/../core/SolverTypes.h \
+ /root/repo/glucose-syrup/parallel/../mtl/IntTypes.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Alg.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Vec.h \
+ /root/repo/glucose-syrup/parallel/../mtl/XAlloc.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Map.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Alloc.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Sort.h \
+ /root/repo/glucose-syrup/parallel/../core/Constants.h \
+ /root/repo/glucose-syrup/parallel/../core/Solver.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Heap.h \
+ /root/repo/glucose-syrup/parallel/../utils/Options.h \
+ /root/repo/glucose-syrup/parallel/../utils/ParseUtils.h \
+ /root/repo/glucose-syrup/parallel/../core/BoundedQueue.h \
+ /root/repo/glucose-syrup/parallel/../core/DratWriter.h \
+ /root/repo/glucose-syrup/parallel/../core/DimacsWriter.h \
+ /root/repo/glucose-syrup/parallel/../core/VMTFQueue.h \
+ /root/repo/glucose-syrup/parallel/../core/LocalSearch.h \
+ /root/repo/glucose-syrup/parallel/../core/PhaseTimers.h \
+ /root/repo/glucose-syrup/parallel/../core/ExternalPropagator.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Clone.h \
+ /root/repo/glucose-syrup/parallel/../simp/SimpSolver.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Queue.h \
+ /root/repo/glucose-syrup/parallel/../parallel/SharedCompanion.h \
+ /root/repo/glucose-syrup/parallel/../parallel/SolverCompanion.h \
+ /root/repo/glucose-syrup/parallel/../parallel/ClausesBuffer.h
+/root/repo/glucose-syrup/parallel/SharedCompanion.o /root/repo/glucose-syrup/parallel/SharedCompanion.or /root/repo/glucose-syrup/parallel/SharedCompanion.od /root/repo/glucose-syrup/parallel/SharedCompanion.op: /root/repo/glucose-syrup/parallel/SharedCompanion.cc \
+ /root/repo/glucose-syrup/parallel/../core/Solver.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Heap.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Vec.h \
+ /root/repo/glucose-syrup/parallel/../mtl/IntTypes.h \
+ /root/repo/glucose-syrup/parallel/../mtl/XAlloc.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Alg.h \
+ /root/repo/glucose-syrup/parallel/../utils/Options.h \
+ /root/repo/glucose-syrup/parallel/../utils/ParseUtils.h \
+ /root/repo/glucose-syrup/parallel/../core/SolverTypes.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Map.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Alloc.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Sort.h \
+ /root/repo/glucose-syrup/parallel/../core/Constants.h \
+ /root/repo/glucose-syrup/parallel/../core/BoundedQueue.h \
+ /root/repo/glucose-syrup/parallel/../core/DratWriter.h \
+ /root/repo/glucose-syrup/parallel/../core/DimacsWriter.h \
+ /root/repo/glucose-syrup/parallel/../core/VMTFQueue.h \
+ /root/repo/glucose-syrup/parallel/../core/LocalSearch.h \
+ /root/repo/glucose-syrup/parallel/../core/PhaseTimers.h \
+ /root/repo/glucose-syrup/parallel/../core/ExternalPropagator.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Clone.h \
+ /root/repo/glucose-syrup/parallel/../parallel/ParallelSolver.h \
+ /root/repo/glucose-syrup/parallel/../simp/SimpSolver.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Queue.h \
+ /root/repo/glucose-syrup/parallel/../parallel/SharedCompanion.h \
+ /root/repo/glucose-syrup/parallel/../parallel/SolverCompanion.h \
+ /root/repo/glucose-syrup/parallel/../parallel/ClausesBuffer.h
+/root/repo/glucose-syrup/parallel/SolverCompanion.o /root/repo/glucose-syrup/parallel/SolverCompanion.or /root/repo/glucose-syrup/parallel/SolverCompanion.od /root/repo/glucose-syrup/parallel/SolverCompanion.op: /root/repo/glucose-syrup/parallel/SolverCompanion.cc \
+ /root/repo/glucose-syrup/parallel/../parallel/SolverCompanion.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Vec.h \
+ /root/repo/glucose-syrup/parallel/../mtl/IntTypes.h \
+ /root/repo/glucose-syrup/parallel/../mtl/XAlloc.h
+/root/repo/glucose-syrup/parallel/SolverConfiguration.o /root/repo/glucose-syrup/parallel/SolverConfiguration.or /root/repo/glucose-syrup/parallel/SolverConfiguration.od /root/repo/glucose-syrup/parallel/SolverConfiguration.op: \
+ /root/repo/glucose-syrup/parallel/SolverConfiguration.cc \
+ /root/repo/glucose-syrup/parallel/../parallel/MultiSolvers.h \
+ /root/repo/glucose-syrup/parallel/../parallel/ParallelSolver.h \
+ /root/repo/glucose-syrup/parallel/../core/SolverTypes.h \
+ /root/repo/glucose-syrup/parallel/../mtl/IntTypes.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Alg.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Vec.h \
+ /root/repo/glucose-syrup/parallel/../mtl/XAlloc.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Map.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Alloc.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Sort.h \
+ /root/repo/glucose-syrup/parallel/../core/Constants.h \
+ /root/repo/glucose-syrup/parallel/../core/Solver.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Heap.h \
+ /root/repo/glucose-syrup/parallel/../utils/Options.h \
+ /root/repo/glucose-syrup/parallel/../utils/ParseUtils.h \
+ /root/repo/glucose-syrup/parallel/../core/BoundedQueue.h \
+ /root/repo/glucose-syrup/parallel/../core/DratWriter.h \
+ /root/repo/glucose-syrup/parallel/../core/DimacsWriter.h \
+ /root/repo/glucose-syrup/parallel/../core/VMTFQueue.h \
+ /root/repo/glucose-syrup/parallel/../core/LocalSearch.h \
+ /root/repo/glucose-syrup/parallel/../core/PhaseTimers.h \
+ /root/repo/glucose-syrup/parallel/../core/ExternalPropagator.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Clone.h \
+ /root/repo/glucose-syrup/parallel/../simp/SimpSolver.h \
+ /root/repo/glucose-syrup/parallel/../mtl/Queue.h \
+ /root/repo/glucose-syrup/parallel/../parallel/SharedCompanion.h \
+ /root/repo/glucose-syrup/parallel/../parallel/SolverCompanion.h \
+ /root/repo/glucose-syrup/parallel/../parallel/ClausesBuffer.h \
+ /root/repo/glucose-syrup/parallel/../parallel/SolverConfiguration.h
+/root/repo/glucose-syrup/simp/Main.o /root/repo/glucose-syrup/simp/Main.or /root/repo/glucose-syrup/simp/Main.od /root/repo/glucose-syrup/simp/Main.op: /root/repo/glucose-syrup/simp/Main.cc \
+ /root/repo/glucose-syrup/simp/../utils/System.h \
+ /root/repo/glucose-syrup/simp/../mtl/IntTypes.h \
+ /root/repo/glucose-syrup/simp/../utils/ParseUtils.h \
+ /root/repo/glucose-syrup/simp/../utils/Options.h \
+ /root/repo/glucose-syrup/simp/../mtl/Vec.h \
+ /root/repo/glucose-syrup/simp/../mtl/XAlloc.h \
+ /root/repo/glucose-syrup/simp/../core/Dimacs.h \
+ /root/repo/glucose-syrup/simp/../core/SolverTypes.h \
+ /root/repo/glucose-syrup/simp/../mtl/Alg.h \
+ /root/repo/glucose-syrup/simp/../mtl/Map.h \
+ /root/repo/glucose-syrup/simp/../mtl/Alloc.h \
+ /root/repo/glucose-syrup/simp/../mtl/Sort.h \
+ /root/repo/glucose-syrup/simp/../core/Constants.h \
+ /root/repo/glucose-syrup/simp/../simp/SimpSolver.h \
+ /root/repo/glucose-syrup/simp/../mtl/Queue.h \
+ /root/repo/glucose-syrup/simp/../core/Solver.h \
+ /root/repo/glucose-syrup/simp/../mtl/Heap.h \
+ /root/repo/glucose-syrup/simp/../core/BoundedQueue.h \
+ /root/repo/glucose-syrup/simp/../core/DratWriter.h \
+ /root/repo/glucose-syrup/simp/../core/DimacsWriter.h \
+ /root/repo/glucose-syrup/simp/../core/VMTFQueue.h \
+ /root/repo/glucose-syrup/simp/../core/LocalSearch.h \
+ /root/repo/glucose-syrup/simp/../core/PhaseTimers.h \
+ /root/repo/glucose-syrup/simp/../core/ExternalPropagator.h \
+ /root/repo/glucose-syrup/simp/../mtl/Clone.h
+/root/repo/glucose-syrup/simp/SimpSolver.o /root/repo/glucose-syrup/simp/SimpSolver.or /root/repo/glucose-syrup/simp/SimpSolver.od /root/repo/glucose-syrup/simp/SimpSolver.op: /root/repo/glucose-syrup/simp/SimpSolver.cc \
+ /root/repo/glucose-syrup/simp/../mtl/Sort.h \
+ /root/repo/glucose-syrup/simp/../mtl/Vec.h \
+ /root/repo/glucose-syrup/simp/../mtl/IntTypes.h \
+ /root/repo/glucose-syrup/simp/../mtl/XAlloc.h \
+ /root/repo/glucose-syrup/simp/../simp/SimpSolver.h \
+ /root/repo/glucose-syrup/simp/../mtl/Queue.h \
+ /root/repo/glucose-syrup/simp/../core/Solver.h \
+ /root/repo/glucose-syrup/simp/../mtl/Heap.h \
+ /root/repo/glucose-syrup/simp/../mtl/Alg.h \
+ /root/repo/glucose-syrup/simp/../utils/Options.h \
+ /root/repo/glucose-syrup/simp/../utils/ParseUtils.h \
+ /root/repo/glucose-syrup/simp/../core/SolverTypes.h \
+ /root/repo/glucose-syrup/simp/../mtl/Map.h \
+ /root/repo/glucose-syrup/simp/../mtl/Alloc.h \
+ /root/repo/glucose-syrup/simp/../core/Constants.h \
+ /root/repo/glucose-syrup/simp/../core/BoundedQueue.h \
+ /root/repo/glucose-syrup/simp/../core/DratWriter.h \
+ /root/repo/glucose-syrup/simp/../core/DimacsWriter.h \
+ /root/repo/glucose-syrup/simp/../core/VMTFQueue.h \
+ /root/repo/glucose-syrup/simp/../core/LocalSearch.h \
+ /root/repo/glucose-syrup/simp/../core/PhaseTimers.h \
+ /root/repo/glucose-syrup/simp/../core/ExternalPropagator.h \
+ /root/repo/glucose-syrup/simp/../mtl/Clone.h \
+ /root/repo/glucose-syrup/simp/../utils/System.h
@@ -83,6 +83,17 @@ void printStats(Solver& solver)
     printf("c propagations          : %-12" PRIu64"   (%.0f /sec)\n", solver.propagations, solver.propagations/cpu_time);
     printf("c conflict literals     : %-12" PRIu64"   (%4.2f %% deleted)\n", solver.tot_literals, (solver.max_literals - solver.tot_literals)*100 / (double)solver.max_literals);
     printf("c nb reduced Clauses    : %" PRIu64"\n",solver.nbReducedClauses);
+#ifdef PROFILE_PHASES
+    solver.phaseTimers.print();
+    printf("c phase times (JSON)    : "); solver.phaseTimers.printJSON(stdout); printf("\n");
+#endif
+    if (solver.nbLocalSearches > 0)
+        printf("c local searches        : %" PRIu64" (%" PRIu64" flips, %d unsat clauses at the last one)\n", solver.nbLocalSearches, solver.lsFlipsTotal, solver.lsLastUnsat);
+    if (solver.nCards() > 0)
+        printf("c cardinality           : %d constraints, %" PRIu64" propagations, %" PRIu64" explanations\n", solver.nCards(), solver.nbCardPropagations, solver.nbCardExplanations);
+    if (solver.nXors() > 0)
+        printf("c XOR constraints       : %d constraints, %" PRIu64" eliminations, %" PRIu64" propagations, %" PRIu64" conflicts, %" PRIu64" explanations\n",
+               solver.nXors(), solver.nbGaussEliminations, solver.nbXorPropagations, solver.nbXorConflicts, solver.nbXorExplanations);
     
     if (mem_used != 0) printf("Memory used           : %.2f MB\n", mem_used);
     printf("c CPU time              : %g s\n", cpu_time);
@@ -129,13 +140,26 @@ int main(int argc, char** argv)
         BoolOption   mod   ("MAIN", "model",   "show model.", false);
         IntOption    vv  ("MAIN", "vv",   "Verbosity every vv conflicts", 10000, IntRange(1,INT32_MAX));
         BoolOption   pre    ("MAIN", "pre",    "Completely turn on/off any preprocessing.", true);
-        StringOption dimacs ("MAIN", "dimacs", "If given, stop after preprocessing and write the result to this file.");
+        StringOption dimacs ("MAIN", "dimacs", "If given, stop after preprocessing and write the result to this file (gzip if it ends with .gz).");
+        StringOption dump   ("MAIN", "dump",   "If given, write the formula with its learnts to this file after the search (gzip if it ends with .gz).");
+        IntOption    dump_lbd("MAIN", "dump-lbd", "Maximal LBD of the learnts written by -dump.\n", 6, IntRange(0, INT32_MAX));
+        BoolOption   dimacs_full("MAIN", "dimacs-full", "Also write the units of level 0 and the reconstruction stack (-dimacs, -dump).", false);
+        BoolOption   dimacs_bin("MAIN", "dimacs-binary", "Write the compact binary form instead of DIMACS (-dimacs, -dump).", false);
         IntOption    cpu_lim("MAIN", "cpu-lim","Limit on CPU time allowed in seconds.\n", INT32_MAX, IntRange(0, INT32_MAX));
         IntOption    mem_lim("MAIN", "mem-lim","Limit on memory usage in megabytes.\n", INT32_MAX, IntRange(0, INT32_MAX));
+        DoubleOption wall_lim("MAIN", "wall-lim","Limit on the wall-clock time of preprocessing and search in seconds (0=none).\n", 0, DoubleRange(0, true, HUGE_VAL, false));
+        StringOption stats_json("MAIN", "stats-json", "If given, append the statistics of each solve call to this file (one line of JSON).");
+        StringOption load_state("MAIN", "load-state", "If given, start from the activities, phases, frozen variables and learnts saved in this file.");
+        StringOption save_state("MAIN", "save-state", "If given, save the activities, phases and frozen variables to this file after solving.");
+        IntOption    state_learnts("MAIN", "state-learnts", "Number of learnts saved with the state (the ones of lowest LBD).\n", 0, IntRange(0, INT32_MAX));
+        IntOption    state_lbd("MAIN", "state-lbd", "Maximal LBD of the learnts saved with the state.\n", 3, IntRange(1, INT32_MAX));
  //       BoolOption opt_incremental ("MAIN","incremental", "Use incremental SAT solving",false);
 
          BoolOption    opt_certified      (_certified, "certified",    "Certified UNSAT using DRUP format", false);
          StringOption  opt_certified_file      (_certified, "certified-output",    "Certified UNSAT output file", "NULL");
+         BoolOption    opt_certified_binary    (_certified, "certified-binary",    "Write the proof in binary DRAT format", false);
+         BoolOption    opt_certified_thread    (_certified, "certified-thread",    "Write the proof from a background thread", false);
+         BoolOption    opt_certified_lrat      (_certified, "certified-lrat",      "Write the proof in LRAT format (turns preprocessing off)", false);
          
         parseOptions(argc, argv, true);
         
@@ -150,13 +174,19 @@ int main(int argc, char** argv)
 	S.showModel = mod;
         
         S.certifiedUNSAT = opt_certified;
+        S.certifiedBinary = opt_certified_binary;
+        S.certifiedThread = opt_certified_thread;
+        S.certifiedLRAT = opt_certified && opt_certified_lrat;
+        if (S.certifiedLRAT)
+            S.eliminate(true); // Turn simplification off: clauses keep the IDs they have in the input
         if(S.certifiedUNSAT) {
             if(!strcmp(opt_certified_file,"NULL")) {
             S.certifiedOutput =  fopen("/dev/stdout", "wb");
             } else {
                 S.certifiedOutput =  fopen(opt_certified_file, "wb");	    
             }
-            fprintf(S.certifiedOutput,"o proof DRUP\n");
+            if (!S.certifiedBinary && !S.certifiedLRAT)
+                fprintf(S.certifiedOutput,"o proof DRUP\n");
         }
 
         solver = &S;
@@ -199,6 +229,9 @@ int main(int argc, char** argv)
             printf("c |                                                                                                       |\n"); }
         
         FILE* res = (argc >= 3) ? fopen(argv[argc-1], "wb") : NULL;
+        FILE* stats = stats_json ? fopen(stats_json, "a") : NULL;
+        if (stats_json && stats == NULL)
+            printf("c WARNING! Could not open the statistics file: %s\n", (const char*)stats_json);
         parse_DIMACS(in, S);
         gzclose(in);
 
@@ -217,6 +250,11 @@ int main(int argc, char** argv)
         signal(SIGXCPU,SIGINT_interrupt);
 
         S.parsing = 0;
+        // Before simplification: the frozen variables must not be eliminated
+        if (load_state && !S.loadState(load_state))
+            printf("c WARNING! Could not load the state file: %s\n", (const char*)load_state);
+        if (wall_lim > 0)
+            S.setTimeBudget(wall_lim);
         if(pre/* && !S.isIncremental()*/) {
 	  printf("c | Preprocesing is fully done\n");
 	  S.eliminate(true);
@@ -227,8 +265,11 @@ int main(int argc, char** argv)
 	}
 	printf("c |                                                                                                       |\n");
         if (!S.okay()){
-            if (S.certifiedUNSAT) fprintf(S.certifiedOutput, "0\n"), fclose(S.certifiedOutput);
+            S.closeProof(true);
             if (res != NULL) fprintf(res, "UNSAT\n"), fclose(res);
+            if (stats != NULL) S.printStatsJSON(stats, 1, l_False), fclose(stats);
+            if (save_state && !S.saveState(save_state, state_learnts, state_lbd))
+                printf("c WARNING! Could not save the state file: %s\n", (const char*)save_state);
             if (S.verbosity > 0){
  	        printf("c =========================================================================================================\n");
                printf("Solved by simplification\n");
@@ -241,7 +282,9 @@ int main(int argc, char** argv)
         if (dimacs){
             if (S.verbosity > 0)
                 printf("c =======================================[ Writing DIMACS ]===============================================\n");
-            S.toDimacs((const char*)dimacs);
+            vec<Lit> as;
+            if (!S.toDimacs((const char*)dimacs, as, -1, dimacs_full, dimacs_bin))
+                printf("c WARNING! Could not write the DIMACS file: %s\n", (const char*)dimacs);
             if (S.verbosity > 0)
                 printStats(S);
             exit(0);
@@ -249,6 +292,11 @@ int main(int argc, char** argv)
 
         vec<Lit> dummy;
         lbool ret = S.solveLimited(dummy);
+        if (dump && !S.toDimacs((const char*)dump, dummy, dump_lbd, dimacs_full, dimacs_bin))
+            printf("c WARNING! Could not write the DIMACS file: %s\n", (const char*)dump);
+        if (stats != NULL) S.printStatsJSON(stats, 1, ret), fclose(stats);
+        if (save_state && !S.saveState(save_state, state_learnts, state_lbd))
+            printf("c WARNING! Could not save the state file: %s\n", (const char*)save_state);
         
         if (S.verbosity > 0){
             printStats(S);
@@ -279,7 +327,7 @@ int main(int argc, char** argv)
 
 	}
 
-        if (S.certifiedUNSAT) fprintf(S.certifiedOutput, "0\n"), fclose(S.certifiedOutput);
+        S.closeProof(false); // (the empty clause has been added by the solver)
 
 #ifdef NDEBUG
         exit(ret == l_True ? 10 : ret == l_False ? 20 : 0);     // (faster than "return", which will invoke the destructor for 'Solver')
@@ -86,12 +86,15 @@ class SimpSolver : public Solver {
     bool    addClause (Lit p, Lit q);        // Add a binary clause to the solver.
     bool    addClause (Lit p, Lit q, Lit r); // Add a ternary clause to the solver.
     virtual bool    addClause_(      vec<Lit>& ps);
+    virtual bool    addAtMost_(      vec<Lit>& ps, int k); // Its variables are frozen: the constraint is not in the occurrence lists.
+    virtual void    observe   (Var v);                     // Frozen as well (the clauses of the external propagator are not in the occurrence lists).
     bool    substitute(Var v, Lit x);  // Replace all occurences of v with x (may cause a contradiction).
 
     // Variable mode:
     // 
     void    setFrozen (Var v, bool b); // If a variable is frozen it will not be eliminated.
     bool    isEliminated(Var v) const;
+    bool    restoreVars (const vec<Var>& vs); // Put back the clauses of the eliminated variables of 'vs' (needs 'restore_elim').
 
     // Solving:
     //
@@ -102,21 +105,22 @@ class SimpSolver : public Solver {
     bool    solve       (Lit p, Lit q,        bool do_simp = true, bool turn_off_simp = false);
     bool    solve       (Lit p, Lit q, Lit r, bool do_simp = true, bool turn_off_simp = false);
     bool    eliminate   (bool turn_off_elim = false);  // Perform variable elimination based simplification. 
+    lbool   backbone    (const vec<Var>& vs, vec<Lit>& out, int chunk = 64); // Literals over 'vs' true in all the models, in 'out' (l_True). Within the budget.
+    lbool   maxsat      (const vec<Lit>& softs, const vec<int64_t>& weights, int64_t& cost); // Soft clauses terminated by 'lit_Undef'. On l_True, 'model' is optimal, of weight 'cost'.
 
     // Memory managment:
     //
     virtual void garbageCollect();
 
+    // Heuristic state kept across runs on versions of the same formula (keyed by variable index):
+    //
+    bool    saveState (const char* file, int max_learnts = 0, int max_lbd = 0); // Activities, phases, frozen variables and at most 'max_learnts' learnts of LBD <= 'max_lbd'.
+    bool    loadState (const char* file);  // Before solving. The learnts are added by the next call to 'solve()', after simplification.
+
 
     // Generate a (possibly simplified) DIMACS file:
     //
-#if 0
-    void    toDimacs  (const char* file, const vec<Lit>& assumps);
-    void    toDimacs  (const char* file);
-    void    toDimacs  (const char* file, Lit p);
-    void    toDimacs  (const char* file, Lit p, Lit q);
-    void    toDimacs  (const char* file, Lit p, Lit q, Lit r);
-#endif
+    virtual void writeDimacs(DimacsWriter& w, const vec<Lit>& assumps, int max_lbd, bool full); // With 'full', also the reconstruction stack.
 
     // Mode of operation:
     //
@@ -130,6 +134,10 @@ class SimpSolver : public Solver {
     bool    use_asymm;         // Shrink clauses by asymmetric branching.
     bool    use_rcheck;        // Check if a clause is already implied. Prett costly, and subsumes subsumptions :)
     bool    use_elim;          // Perform variable elimination.
+    bool    restore_elim;      // Keep both sides of the clauses of an eliminated variable, so that it can be restored.
+    int     xor_size;          // Largest XOR constraints looked for in the clauses (with 'useGauss').
+    bool    maxsat_strat;      // Stratify the weights of the soft clauses in 'maxsat()'.
+    int     maxsat_min;        // Conflicts allowed to drop each literal of a MaxSAT core (0 means no core minimization).
     // Statistics:
     //
     int     merges;
@@ -174,8 +182,16 @@ class SimpSolver : public Solver {
     Queue<CRef>         subsumption_queue;
     vec<char>           frozen;
     vec<char>           eliminated;
+    vec<char>           restorable;       // Eliminated with both sides of its clauses kept (see 'restore_elim').
     int                 bwdsub_assigns;
     int                 n_touched;
+    bool                xors_searched;    // XOR constraints are only looked for by the first call to 'eliminate()'.
+    vec<Lit>            loaded_learnts;   // Learnts read by 'loadState()', each one terminated by 'lit_Undef'.
+    vec<int>            loaded_lbds;
+    vec<vec<Lit> >      tot_outs;         // Totalizers of 'maxsat()': 'tot_outs[t][k]' is implied by k+1 true inputs of node 't'.
+    vec<int>            tot_left;         // Children of each node (-1 for the leaves, whose only output is their input).
+    vec<int>            tot_right;
+    vec<int>            tot_leaves;
 
     // Temporaries:
     //
@@ -192,13 +208,19 @@ class SimpSolver : public Solver {
     bool          merge                    (const Clause& _ps, const Clause& _qs, Var v, int& size);
     bool          backwardSubsumptionCheck (bool verbose = false);
     bool          eliminateVar             (Var v);
+    void          findXors                 ();
     void          extendModel              ();
     void	unsatExplanation();
     void          removeClause             (CRef cr,bool inPurgatory=false);
     bool          strengthenClause         (CRef cr, Lit l);
     void          cleanUpClauses           ();
     bool          implied                  (const vec<Lit>& c);
+    bool          addLoadedLearnts         ();
+    void          minimizeCore             (vec<Lit>& core);
+    int           buildTotalizer           (const vec<Lit>& ins, int from, int to);
+    bool          extendTotalizer          (int t, int k);
     virtual void          relocAll                 (ClauseAllocator& to);
+    virtual void          liveClauses              (vec<CRef>& cs);
 };
 
 
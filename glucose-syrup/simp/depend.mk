@@ -0,0 +1,51 @@
+/root/repo/glucose-syrup/simp/Main.o /root/repo/glucose-syrup/simp/Main.or /root/repo/glucose-syrup/simp/Main.od /root/repo/glucose-syrup/simp/Main.op: /root/repo/glucose-syrup/simp/Main.cc \
+ /root/repo/glucose-syrup/simp/../utils/System.h \
+ /root/repo/glucose-syrup/simp/../mtl/IntTypes.h \
+ /root/repo/glucose-syrup/simp/../utils/ParseUtils.h \
+ /root/repo/glucose-syrup/simp/../utils/Options.h \
+ /root/repo/glucose-syrup/simp/../mtl/Vec.h \
+ /root/repo/glucose-syrup/simp/../mtl/XAlloc.h \
+ /root/repo/glucose-syrup/simp/../core/Dimacs.h \
+ /root/repo/glucose-syrup/simp/../core/SolverTypes.h \
+ /root/repo/glucose-syrup/simp/../mtl/Alg.h \
+ /root/repo/glucose-syrup/simp/../mtl/Map.h \
+ /root/repo/glucose-syrup/simp/../mtl/Alloc.h \
+ /root/repo/glucose-syrup/simp/../mtl/Sort.h \
+ /root/repo/glucose-syrup/simp/../core/Constants.h \
+ /root/repo/glucose-syrup/simp/../simp/SimpSolver.h \
+ /root/repo/glucose-syrup/simp/../mtl/Queue.h \
+ /root/repo/glucose-syrup/simp/../core/Solver.h \
+ /root/repo/glucose-syrup/simp/../mtl/Heap.h \
+ /root/repo/glucose-syrup/simp/../core/BoundedQueue.h \
+ /root/repo/glucose-syrup/simp/../core/DratWriter.h \
+ /root/repo/glucose-syrup/simp/../core/DimacsWriter.h \
+ /root/repo/glucose-syrup/simp/../core/VMTFQueue.h \
+ /root/repo/glucose-syrup/simp/../core/LocalSearch.h \
+ /root/repo/glucose-syrup/simp/../core/PhaseTimers.h \
+ /root/repo/glucose-syrup/simp/../core/ExternalPropagator.h \
+ /root/repo/glucose-syrup/simp/../mtl/Clone.h
+/root/repo/glucose-syrup/simp/SimpSolver.o /root/repo/glucose-syrup/simp/SimpSolver.or /root/repo/glucose-syrup/simp/SimpSolver.od /root/repo/glucose-syrup/simp/SimpSolver.op: /root/repo/glucose-syrup/simp/SimpSolver.cc \
+ /root/repo/glucose-syrup/simp/../mtl/Sort.h \
+ /root/repo/glucose-syrup/simp/../mtl/Vec.h \
+ /root/repo/glucose-syrup/simp/../mtl/IntTypes.h \
+ /root/repo/glucose-syrup/simp/../mtl/XAlloc.h \
+ /root/repo/glucose-syrup/simp/../simp/SimpSolver.h \
+ /root/repo/glucose-syrup/simp/../mtl/Queue.h \
+ /root/repo/glucose-syrup/simp/../core/Solver.h \
+ /root/repo/glucose-syrup/simp/../mtl/Heap.h \
+ /root/repo/glucose-syrup/simp/../mtl/Alg.h \
+ /root/repo/glucose-syrup/simp/../utils/Options.h \
+ /root/repo/glucose-syrup/simp/../utils/ParseUtils.h \
+ /root/repo/glucose-syrup/simp/../core/SolverTypes.h \
+ /root/repo/glucose-syrup/simp/../mtl/Map.h \
+ /root/repo/glucose-syrup/simp/../mtl/Alloc.h \
+ /root/repo/glucose-syrup/simp/../core/Constants.h \
+ /root/repo/glucose-syrup/simp/../core/BoundedQueue.h \
+ /root/repo/glucose-syrup/simp/../core/DratWriter.h \
+ /root/repo/glucose-syrup/simp/../core/DimacsWriter.h \
+ /root/repo/glucose-syrup/simp/../core/VMTFQueue.h \
+ /root/repo/glucose-syrup/simp/../core/LocalSearch.h \
+ /root/repo/glucose-syrup/simp/../core/PhaseTimers.h \
+ /root/repo/glucose-syrup/simp/../core/ExternalPropagator.h \
+ /root/repo/glucose-syrup/simp/../mtl/Clone.h \
+ /root/repo/glucose-syrup/simp/../utils/System.h
@@ -68,6 +68,7 @@ static inline int memReadPeak(void)
 }
 
 double Glucose::memUsed() { return (double)memReadStat(0) * (double)getpagesize() / (1024*1024); }
+double Glucose::memResident() { return (double)memReadStat(1) * (double)getpagesize() / (1024*1024); }
 double Glucose::memUsedPeak() { 
     double peak = memReadPeak() / 1024;
     return peak == 0 ? memUsed() : peak; }
@@ -93,3 +94,7 @@ double Glucose::memUsed(void) {
 double Glucose::memUsed() { 
     return 0; }
 #endif
+
+#if !defined(__linux__)
+double Glucose::memResident() { return memUsed(); }
+#endif
@@ -6,6 +6,10 @@ IncrementalSolver::IncrementalSolver() :
   buffer((int *)malloc(sizeof(int)*IS_BUFFERSIZE)),
   solution(NULL),
   solutionsize(0),
+  backbonelits(NULL),
+  backbonesize(0),
+  backbonecapacity(0),
+  cost(0),
   offset(0)
 {
   createSolver();
@@ -14,6 +18,8 @@ IncrementalSolver::IncrementalSolver() :
 IncrementalSolver::~IncrementalSolver() {
   killSolver();
   free(buffer);
+  if (backbonelits != NULL)
+    free(backbonelits);
 }
 
 void IncrementalSolver::reset() {
@@ -38,24 +44,103 @@ void IncrementalSolver::freeze(int variable) {
   addClauseLiteral(variable);
 }
 
+// At most k of the literals are true. Like freeze, only between
+// finishedClauses and solve.
+void IncrementalSolver::addAtMost(int k, const int * literals, int size) {
+  addClauseLiteral(IS_ATMOST);
+  addClauseLiteral(k);
+  addClauseLiteral(size);
+  for(int i=0;i<size;i++)
+    addClauseLiteral(literals[i]);
+}
+
 int IncrementalSolver::solve() {
   //add an empty clause
   addClauseLiteral(IS_RUNSOLVER);
   flushBuffer();
   int result=readIntSolver();
+  if (result == IS_SAT)
+    readModel();
+  return result;
+}
+
+void IncrementalSolver::readModel() {
+  int numVars=readIntSolver();
+  if (numVars > solutionsize) {
+    if (solution != NULL)
+      free(solution);
+    solution = (int *) malloc((numVars+1)*sizeof(int));
+    solution[0] = 0;
+  }
+  readSolver(&solution[1], numVars * sizeof(int));
+}
+
+// Literals over the variables that are true in all the models,
+// computed in one call to the solver. Like solve, ends the commands.
+// On IS_SAT, they are given by getBackbone. Freeze the variables
+// before the first solve: for the ones an earlier solve eliminated,
+// the glucose server restores them and the lingeling server answers
+// IS_INDETER.
+int IncrementalSolver::backbone(const int * variables, int size) {
+  addClauseLiteral(IS_BACKBONE);
+  addClauseLiteral(size);
+  for(int i=0;i<size;i++)
+    addClauseLiteral(variables[i]);
+  flushBuffer();
+  backbonesize = 0;
+  int result=readIntSolver();
   if (result == IS_SAT) {
-    int numVars=readIntSolver();
-    if (numVars > solutionsize) {
-      if (solution != NULL)
-        free(solution);
-      solution = (int *) malloc((numVars+1)*sizeof(int));
-      solution[0] = 0;
+    backbonesize=readIntSolver();
+    if (backbonesize > backbonecapacity) {
+      if (backbonelits != NULL)
+        free(backbonelits);
+      backbonelits = (int *) malloc(backbonesize*sizeof(int));
+      backbonecapacity = backbonesize;
     }
-    readSolver(&solution[1], numVars * sizeof(int));
+    readSolver(backbonelits, backbonesize * sizeof(int));
+  }
+  return result;
+}
+
+int IncrementalSolver::getBackboneSize() {
+  return backbonesize;
+}
+
+const int * IncrementalSolver::getBackbone() {
+  return backbonelits;
+}
+
+// Minimize the weight of the falsified soft clauses: clause i has
+// weight weights[i] and its sizes[i] literals follow the ones of the
+// previous clauses in literals. Like solve, ends the commands. On
+// IS_SAT, the model is optimal and getCost gives its weight. The
+// glucose server first restores the variables of the soft clauses
+// that an earlier solve eliminated (freezing them avoids it). The
+// lingeling and zChaff servers always answer IS_INDETER.
+int IncrementalSolver::solveMaxSAT(int nsoft, const int * weights, const int * sizes, const int * literals) {
+  addClauseLiteral(IS_MAXSAT);
+  addClauseLiteral(nsoft);
+  for(int i=0;i<nsoft;i++) {
+    addClauseLiteral(weights[i]);
+    addClauseLiteral(sizes[i]);
+    for(int j=0;j<sizes[i];j++)
+      addClauseLiteral(*literals++);
+  }
+  flushBuffer();
+  int result=readIntSolver();
+  if (result == IS_SAT) {
+    unsigned int high=readIntSolver();
+    unsigned int low=readIntSolver();
+    cost = ((long long) high << 32) | low;
+    readModel();
   }
   return result;
 }
 
+long long IncrementalSolver::getCost() {
+  return cost;
+}
+
 int IncrementalSolver::readIntSolver() {
   int value;
   readSolver(&value, 4);
@@ -14,7 +14,13 @@ class IncrementalSolver {
   void addClauseLiteral(int literal);
   void finishedClauses();
   void freeze(int variable);
+  void addAtMost(int k, const int * literals, int size);
   int solve();
+  int backbone(const int * variables, int size);
+  int getBackboneSize();
+  const int * getBackbone();
+  int solveMaxSAT(int nsoft, const int * weights, const int * sizes, const int * literals);
+  long long getCost();
   bool getValue(int variable);
   void reset();
 
@@ -24,9 +30,14 @@ class IncrementalSolver {
   void flushBuffer();
   int readIntSolver();
   void readSolver(void * buffer, ssize_t size);
+  void readModel();
   int * buffer;
   int * solution;
   int solutionsize;
+  int * backbonelits;
+  int backbonesize;
+  int backbonecapacity;
+  long long cost;
   int offset;
   pid_t solver_pid;
   int to_solver_fd;
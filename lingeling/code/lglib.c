@@ -26091,6 +26091,42 @@ int64_t lglgetdecs (LGL * lgl) {
   return lgl->stats->decisions;
 }
 
+// One line of JSON with the same schema as Glucose's 'printStatsJSON'
+// (counters, timings in seconds and memory in MB) after a call to 'lglsat'
+// which returned 'res'.
+
+void lglstatsjson (LGL * lgl, FILE * file, int res) {
+  Stats * s;
+  Times * t;
+  REQINITNOTFORKED ();
+  lglflushtimers (lgl);
+  s = lgl->stats;
+  t = lgl->times;
+  fprintf (file,
+    "{\"schema\": 1, \"solver\": \"lingeling\", \"event\": \"solve\", "
+    "\"call\": %lld, \"result\": \"%s\", ",
+    (LGLL) s->calls.sat, res == 10 ? "SAT" : res == 20 ? "UNSAT" : "UNKNOWN");
+  fprintf (file,
+    "\"counters\": {\"conflicts\": %lld, \"decisions\": %lld, "
+    "\"propagations\": %lld, \"restarts\": %d, \"vars\": %d, "
+    "\"clauses\": %d, \"reductions\": %d, \"gcs\": %d}, ",
+    (LGLL) s->confs, (LGLL) s->decisions,
+    (LGLL) (s->props.search + s->props.simp + s->props.lkhd),
+    s->restarts.count, lglnvars (lgl), lglnclauses (lgl),
+    s->reduced.count, s->gcs);
+  fprintf (file,
+    "\"timings\": {\"cpu\": %.3f, \"phases\": {"
+    "\"search\": {\"seconds\": %.6f}, \"preprocessing\": {\"seconds\": %.6f}, "
+    "\"inprocessing\": {\"seconds\": %.6f}, \"analyze\": {\"seconds\": %.6f}, "
+    "\"reduce\": {\"seconds\": %.6f}, \"garbageCollect\": {\"seconds\": %.6f}, "
+    "\"eliminate\": {\"seconds\": %.6f}, \"probe\": {\"seconds\": %.6f}}}, ",
+    t->all, t->srch, t->prep, t->inpr, t->ana, t->red, t->gc, t->elm,
+    t->prb.all);
+  fprintf (file, "\"memory\": {\"mb\": %.1f, \"peak_mb\": %.1f}}\n",
+    lglmb (lgl), lglmaxmb (lgl));
+  fflush (file);
+}
+
 void lglsizes (LGL * lgl) {
   lglprt (lgl, 0, "sizeof (int) == %ld", (long) sizeof (int));
   lglprt (lgl, 0, "sizeof (unsigned) == %ld", (long) sizeof (unsigned));
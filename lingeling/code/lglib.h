@@ -319,6 +319,7 @@ void lglflushtimers (LGL *lgl);			// after interrupt etc.
 void lglstats (LGL *);
 int64_t lglgetconfs (LGL *);
 int64_t lglgetdecs (LGL *);
+void lglstatsjson (LGL *, FILE *, int res);	// one line of JSON
 int64_t lglgetprops (LGL *);
 size_t lglbytes (LGL *);
 int lglnvars (LGL *);
@@ -13,9 +13,11 @@
 #include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
+#include <sys/resource.h>
 #include "solver_interface.h"
 
 static LGL * lgl4sigh;
+static FILE * statsjson;	// statistics of each call (one JSON line)
 static int catchedsig, verbose, ignmissingheader, ignaddcls;
 
 static void (*sig_int_handler)(int);
@@ -183,6 +185,71 @@ void readClauses(LGL *solver) {
   }
 }
 
+static int backbonechunk = 64;	// candidates assumed by one call
+
+/* Literals over 'vars' true in all the models, put in 'out'.  The
+ * candidates of a first model are filtered by the later models and tested
+ * by assuming the negation of up to 'backbonechunk' of them at once.  A
+ * single failed assumption is in the backbone and added as a unit, more
+ * failed assumptions halve the chunk.  Melted variables are reused, or
+ * taken from the top level if fixed; the answer is 0 if one of them was
+ * eliminated or substituted.
+ */
+int backbone(LGL *solver, int *vars, int size, int *out, int *nout) {
+  int *cands, ncands, nassumed, nfailed, failed, chunk, res, i, j, val;
+  *nout = 0;
+  if (lglinconsistent(solver)) return 20;
+  for(i=0;i<size;i++) {
+    if (!lglusable(solver, vars[i])) {
+      if (lglfixed(solver, vars[i])) continue;
+      if (!lglreusable(solver, vars[i])) return 0;
+      lglreuse(solver, vars[i]);
+    }
+    lglfreeze(solver, vars[i]);
+  }
+  res = lglsat(solver);
+  if (res != 10) return res;
+  cands = malloc(sizeof(int)*size);
+  ncands = 0;
+  for(i=0;i<size;i++)
+    if (!lglusable(solver, vars[i])) {
+      val = lglfixed(solver, vars[i]);
+      out[(*nout)++] = val > 0 ? vars[i] : -vars[i];
+    } else
+      cands[ncands++] = lglderef(solver, vars[i]) > 0 ? vars[i] : -vars[i];
+  chunk = backbonechunk;
+  while(ncands > 0) {
+    for(i=j=0;i<ncands;i++)
+      if (lglfixed(solver, cands[i]) > 0) out[(*nout)++] = cands[i];
+      else cands[j++] = cands[i];
+    if (!(ncands = j)) break;
+    nassumed = ncands < chunk ? ncands : chunk;
+    for(i=ncands-nassumed;i<ncands;i++)
+      lglassume(solver, -cands[i]);
+    res = lglsat(solver);
+    if (res == 10) {
+      //model filtering
+      for(i=j=0;i<ncands;i++)
+        if (lglderef(solver, cands[i]) > 0) cands[j++] = cands[i];
+      ncands = j;
+      chunk = backbonechunk;
+    } else if (res == 20) {
+      nfailed = failed = 0;
+      for(i=ncands-nassumed;i<ncands;i++)
+        if (lglfailed(solver, -cands[i])) { failed = i; nfailed++; }
+      if (!nfailed) break;
+      if (nfailed == 1) {
+        lgladd(solver, cands[failed]);
+        lgladd(solver, 0);
+        out[(*nout)++] = cands[failed];
+        cands[failed] = cands[--ncands];
+      } else if (chunk > 1) chunk /= 2;
+    } else break;
+  }
+  free(cands);
+  return ncands ? res : 10;
+}
+
 void processCommands(LGL *solver) {
   while(true) {
     int command=getInt();
@@ -192,8 +259,46 @@ void processCommands(LGL *solver) {
       lglfreeze(solver, var);
       break;
     }
+    case IS_BACKBONE: {
+      int size=getInt();
+      int *vars=malloc(sizeof(int)*size);
+      int *out=malloc(sizeof(int)*size);
+      int nout;
+      for(int i=0;i<size;i++)
+        vars[i]=getInt();
+      int ret = backbone(solver, vars, size, out, &nout);
+      if (statsjson) lglstatsjson (solver, statsjson, ret);
+      if (ret == 10) {
+        putInt(IS_SAT);
+        putInt(nout);
+        for(int i=0;i<nout;i++)
+          putInt(out[i]);
+      } else if (ret == 20) {
+        putInt(IS_UNSAT);
+      } else {
+        putInt(IS_INDETER);
+      }
+      flushInts();
+      free(vars);
+      free(out);
+      return;
+    }
+    case IS_MAXSAT: {
+      //no MaxSAT search here: read the soft clauses, answer unknown
+      int nsoft=getInt();
+      for(int i=0;i<nsoft;i++) {
+        getInt();
+        int size=getInt();
+        for(int j=0;j<size;j++)
+          getInt();
+      }
+      putInt(IS_INDETER);
+      flushInts();
+      return;
+    }
     case IS_RUNSOLVER: {
       int ret = lglsat(solver);
+      if (statsjson) lglstatsjson (solver, statsjson, ret);
       if (ret == 10) {
         putInt(IS_SAT);
         int numvars=lglmaxvar(solver);
@@ -257,6 +362,8 @@ int main (int argc, char ** argv) {
       printf ("-s               only simplify and print to output file\n");
       printf ("-O<L>            set simplification level to <L>\n");
       printf ("-p <options>     read options from file\n");
+      printf ("--stats-json <file>  append statistics of each call to file\n");
+      printf ("--backbone-chunk=<n>  assumed backbone candidates (default 64)\n");
       printf ("\n");
       printf ("-t <seconds>     set time limit\n");
       printf ("\n");
@@ -313,6 +420,19 @@ int main (int argc, char ** argv) {
 	goto DONE;
       }
       pname = argv[i];
+    } else if (!strcmp (argv[i], "--stats-json")) {
+      if (++i == argc) {
+	fprintf (stderr,
+	  "*** lingeling error: argument to '--stats-json' missing\n");
+	res = 1;
+	goto DONE;
+      }
+      if (!(statsjson = fopen (argv[i], "a"))) {
+	fprintf (stderr,
+	  "*** lingeling error: can not write statistics to %s\n", argv[i]);
+	res = 1;
+	goto DONE;
+      }
     } else if (!strcmp (argv[i], "-t")) {
       if (++i == argc) {
 	fprintf (stderr, "*** lingeling error: argument to '-t' missing\n");
@@ -375,6 +495,9 @@ int main (int argc, char ** argv) {
 	  } else if (!strncmp (argv[i], "--thanks=", len)) {
 	    thanks = match + 1;
 	    continue;
+	  } else if (!strncmp (argv[i], "--backbone-chunk=", len)) {
+	    if ((backbonechunk = atoi (match + 1)) <= 0) goto ERR;
+	    continue;
 	  } else if (!isdigit (*p)) {
 ERR:
             fprintf (stderr,
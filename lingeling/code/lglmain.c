@@ -332,16 +332,16 @@ static int nprimes = sizeof primes / sizeof *primes;
 
 int main (int argc, char ** argv) {
   int res, i, j, clin, clout, val, len, lineno, simponly, count, target;
-  const char * iname, * oname, * pname, * match, * p, * err, * thanks;
+  const char * iname, * oname, * pname, * sname, * match, * p, * err, * thanks;
   int maxvar, lit, nopts, simplevel;
-  FILE * in, * out, * pfile;
+  FILE * in, * out, * pfile, * sfile;
   char * tmp;
   LGL * lgl;
   OBuf obuf;
   lineno = 1;
   in = out = 0;
   res = clin = clout = simponly = simplevel = 0;
-  iname = oname = pname = thanks = 0;
+  iname = oname = pname = sname = thanks = 0;
   lgl4sigh = lgl = lglinit ();
   setsighandlers ();
   for (i = 1; i < argc; i++) {
@@ -355,6 +355,7 @@ int main (int argc, char ** argv) {
       printf ("-O<L>            set simplification level to <L>\n");
       printf ("-o <output>      set output file (default 'stdout')\n");
       printf ("-p <options>     read options from file\n");
+      printf ("--stats-json <file>  append statistics to file (one JSON line)\n");
       printf ("\n");
       printf ("-t <seconds>     set time limit\n");
       printf ("\n");
@@ -428,6 +429,14 @@ int main (int argc, char ** argv) {
 	goto DONE;
       }
       pname = argv[i];
+    } else if (!strcmp (argv[i], "--stats-json")) {
+      if (++i == argc) {
+	fprintf (stderr,
+	  "*** lingeling error: argument to '--stats-json' missing\n");
+	res = 1;
+	goto DONE;
+      }
+      sname = argv[i];
     } else if (!strcmp (argv[i], "-t")) {
       if (++i == argc) {
 	fprintf (stderr, "*** lingeling error: argument to '-t' missing\n");
@@ -702,6 +711,14 @@ ERR:
     caughtalarm = 0;
     (void) signal (SIGALRM, sig_alrm_handler);
   }
+  if (sname) {
+    if ((sfile = fopen (sname, "a"))) {
+      lglstatsjson (lgl, sfile, res);
+      fclose (sfile);
+    } else
+      fprintf (stderr,
+        "*** lingeling warning: can not write statistics to %s\n", sname);
+  }
   if (oname) {
     double start = lglsec (lgl), delta;
     if (!strcmp (oname, "-")) out = stdout, oname = "<stdout>", clout = 0;
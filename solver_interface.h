@@ -8,6 +8,9 @@
 #define IS_INDETER 2
 #define IS_FREEZE 3
 #define IS_RUNSOLVER 4
+#define IS_ATMOST 5
+#define IS_BACKBONE 6
+#define IS_MAXSAT 7
 
 #define IS_BUFFERSIZE 1024
 
@@ -1,5 +1,59 @@
 #include "inc_solver.h"
 
+// MaxSAT, optionally after a solve call that may eliminate the
+// variables of the soft clauses.
+void testMaxSAT(bool presolve, bool weighted) {
+  IncrementalSolver * s=new IncrementalSolver();
+  long long expected;
+  int result;
+  if (!weighted) {
+    //each pair of 1, 2, 3 has a true variable: two of -1, -2, -3 are false
+    int hard[]={1,2,0, 1,3,0, 2,3,0};
+    int weights[]={1,1,1}, sizes[]={1,1,1}, softs[]={-1,-2,-3};
+    for(unsigned int i=0;i<sizeof(hard)/sizeof(int);i++) s->addClauseLiteral(hard[i]);
+    s->finishedClauses();
+    if (presolve) { printf("solution=%d\n", s->solve()); s->finishedClauses(); }
+    result=s->solveMaxSAT(3, weights, sizes, softs);
+    expected=2;
+  } else {
+    //1 or the chain 2 -> 3 -> 4: best is 1=0, 2=3=4=1
+    int hard[]={1,2,0, -2,3,0, -3,4,0};
+    int weights[]={4,2,1}, sizes[]={1,1,2}, softs[]={-1, -4, -2,-3};
+    for(unsigned int i=0;i<sizeof(hard)/sizeof(int);i++) s->addClauseLiteral(hard[i]);
+    s->finishedClauses();
+    if (presolve) { printf("solution=%d\n", s->solve()); s->finishedClauses(); }
+    result=s->solveMaxSAT(3, weights, sizes, softs);
+    expected=3;
+  }
+  printf("maxsat=%d cost=%lld (expected %lld)\n", result, s->getCost(), expected);
+  delete s;
+}
+
+// Backbone of 1..7, optionally after a solve call that may eliminate
+// some of them.
+void testBackbone(bool presolve) {
+  IncrementalSolver * s=new IncrementalSolver();
+  //1 by resolution on 2, then 4 through 3, then 5 through 6
+  int hard[]={1,2,0, 1,-2,0, -1,3,4,0, -3,4,0, -4,5,6,0, -6,5,0, 6,7,0};
+  int vars[]={1,2,3,4,5,6,7};
+  for(unsigned int i=0;i<sizeof(hard)/sizeof(int);i++) s->addClauseLiteral(hard[i]);
+  s->finishedClauses();
+  if (presolve) { printf("solution=%d\n", s->solve()); s->finishedClauses(); }
+  int result=s->backbone(vars, 7);
+  printf("backbone=%d:", result);
+  bool in[8]={false};
+  for(int i=0;i<s->getBackboneSize();i++) {
+    int lit=s->getBackbone()[i];
+    printf(" %d", lit);
+    if (lit > 0 && lit < 8) in[lit]=true;
+  }
+  //IS_INDETER is right after a solve for the servers that cannot restore
+  //the eliminated variables
+  bool right=result == IS_SAT ? s->getBackboneSize() == 3 && in[1] && in[4] && in[5] : presolve && result == IS_INDETER;
+  printf(" (expected 1 4 5 in any order)%s\n", right ? "" : " WRONG");
+  delete s;
+}
+
 int main(int argc, char **argv) {
   IncrementalSolver * s=new IncrementalSolver();
   s->addClauseLiteral(1);s->addClauseLiteral(2);s->addClauseLiteral(0);
@@ -22,4 +76,8 @@ int main(int argc, char **argv) {
     printf("%d: %d\n",i, s->getValue(i));
   }
   delete s;
+  for(int i=0;i<4;i++)
+    testMaxSAT(i&1, i&2);
+  for(int i=0;i<2;i++)
+    testBackbone(i);
 }
@@ -36,6 +36,8 @@
 #ifndef __SAT_HEADER__
 #define __SAT_HEADER__
 
+#include <stdio.h>
+
 #define SAT_Manager void *
 
 typedef long long long64;  // this is for 32 bit unix machines
@@ -322,9 +324,15 @@ int SAT_Random_Seed(SAT_Manager mng);
 
 long64 SAT_NumImplications(SAT_Manager mng);
 
+int SAT_NumRestarts(SAT_Manager mng);
+
 int SAT_MaxDLevel(SAT_Manager mng);
 
 float SAT_AverageBubbleMove(SAT_Manager mng);
+
+// Write the statistics of a call to SAT_Solve as one line of JSON, with the
+// same schema as glucose and lingeling. 'call' numbers the calls from 1.
+void SAT_PrintStatsJSON(SAT_Manager mng, FILE * file, int call, int outcome);
 // Following function will allow you to traverse all the
 // clauses and literals. Clause is represented by a index.
 // The original clauses' indice are not changed during the
@@ -38,6 +38,7 @@
 #include <fstream>
 #include <cstdlib>
 #include <cstdio>
+#include <string.h>
 
 #include <set>
 #include <vector>
@@ -110,6 +111,8 @@ void putInt(int value) {
 }
 
 int numvars=0;
+FILE *statsjson=NULL; // statistics of each solve call (one line of JSON)
+int numcalls=0;
 void readClauses(SAT_Manager solver) {
   vector<int> clause;
   bool haveClause = false;
@@ -138,6 +141,69 @@ void readClauses(SAT_Manager solver) {
 }
 bool first=true;;
 
+int backbonechunk=64; // candidates refuted by one solve call
+
+int solveFrom(SAT_Manager solver) {
+  if (!first) {
+    SAT_Reset(solver);
+  }
+  first=false;
+  return SAT_Solve(solver);
+}
+
+// Literals over vars true in all the models. zChaff has no assumptions:
+// the negations of up to backbonechunk candidates are added as units in a
+// deletable clause group, which keeps the other learnt clauses. A single
+// refuted candidate is in the backbone and added as a permanent unit, a
+// refuted chunk is halved. The candidates left are filtered by each model.
+int backbone(SAT_Manager solver, vector<int> & vars, vector<int> & out) {
+  out.clear();
+  int ret = solveFrom(solver);
+  if (ret != SATISFIABLE)
+    return ret;
+  vector<int> cands;
+  for(unsigned int i=0;i<vars.size();i++) {
+    int value=SAT_GetVarAsgnment(solver, vars[i]);
+    if (value != -1)
+      cands.push_back(value==1 ? vars[i] : -vars[i]);
+  }
+  unsigned int chunk=backbonechunk;
+  while(!cands.empty()) {
+    unsigned int nassumed = cands.size() < chunk ? cands.size() : chunk;
+    int gid=SAT_AllocClauseGroupID(solver);
+    for(unsigned int i=cands.size()-nassumed;i<cands.size();i++) {
+      int lit=abs(cands[i]) << 1;
+      if (cands[i] > 0) lit++;
+      SAT_AddClause(solver, &lit, 1, gid);
+    }
+    ret = solveFrom(solver);
+    if (ret == SATISFIABLE) {
+      //model filtering
+      unsigned int j=0;
+      for(unsigned int i=0;i<cands.size();i++)
+        if (SAT_GetVarAsgnment(solver, abs(cands[i]))==(cands[i] > 0))
+          cands[j++]=cands[i];
+      cands.resize(j);
+      chunk=backbonechunk;
+    }
+    SAT_DeleteClauseGroup(solver, gid);
+    if (ret == UNSATISFIABLE) {
+      if (nassumed == 1) {
+        int lit=abs(cands.back()) << 1;
+        if (cands.back() < 0) lit++;
+        SAT_AddClause(solver, &lit, 1);
+        out.push_back(cands.back());
+        cands.pop_back();
+      } else {
+        chunk /= 2;
+      }
+    } else if (ret != SATISFIABLE) {
+      return ret;
+    }
+  }
+  return SATISFIABLE;
+}
+
 void processCommands(SAT_Manager solver) {
   while(true) {
     int command=getInt();
@@ -146,12 +212,50 @@ void processCommands(SAT_Manager solver) {
       int var=getInt();
       break;
     }
-    case IS_RUNSOLVER: {
-      if (!first) {
-        SAT_Reset(solver);
+    case IS_BACKBONE: {
+      int size=getInt();
+      vector<int> vars, out;
+      for(int i=0;i<size;i++) {
+        int var=getInt();
+        while (var > numvars) {
+          numvars++;
+          SAT_AddVariable(solver);
+        }
+        vars.push_back(var);
       }
-      first=false;
-      int ret = SAT_Solve(solver);
+      int ret = backbone(solver, vars, out);
+      if (statsjson) SAT_PrintStatsJSON(solver, statsjson, ++numcalls, ret);
+
+      if (ret == SATISFIABLE) {
+        putInt(IS_SAT);
+        putInt(out.size());
+        for(unsigned int i=0;i<out.size();i++) {
+          putInt(out[i]);
+        }
+      } else if (ret == UNSATISFIABLE) {
+        putInt(IS_UNSAT);
+      } else {
+        putInt(IS_INDETER);
+      }
+      flushInts();
+      return;
+    }
+    case IS_MAXSAT: {
+      //no MaxSAT search here: read the soft clauses, answer unknown
+      int nsoft=getInt();
+      for(int i=0;i<nsoft;i++) {
+        getInt();
+        int size=getInt();
+        for(int j=0;j<size;j++)
+          getInt();
+      }
+      putInt(IS_INDETER);
+      flushInts();
+      return;
+    }
+    case IS_RUNSOLVER: {
+      int ret = solveFrom(solver);
+      if (statsjson) SAT_PrintStatsJSON(solver, statsjson, ++numcalls, ret);
       
       if (ret == SATISFIABLE) {
         putInt(IS_SAT);
@@ -193,6 +297,17 @@ void processSAT(SAT_Manager solver) {
 
 int main(int argc, char ** argv) {
   SAT_Manager mng = SAT_InitManager();
+  for(int i=1;i<argc;i++) {
+    if (!strcmp(argv[i], "--stats-json") && i+1 < argc) {
+      statsjson = fopen(argv[++i], "a");
+      if (!statsjson) {
+        fprintf(stderr, "Can't open statistics file %s\n", argv[i]);
+        exit(1);
+      }
+    } else if (!strncmp(argv[i], "--backbone-chunk=", 17) && atoi(argv[i]+17) > 0) {
+      backbonechunk = atoi(argv[i]+17);
+    }
+  }
   processSAT(mng);
   return 0;
 }
@@ -246,10 +246,20 @@ void verify_solution(SAT_Manager mng)
 int main(int argc, char ** argv)
 {
     SAT_Manager mng = SAT_InitManager();
+    char * stats_json = NULL;
+    for (int i = 1; i < argc; ++i) {    // remove "--stats-json <file>" from the arguments
+        if (!strcmp(argv[i], "--stats-json") && i + 1 < argc) {
+            stats_json = argv[i + 1];
+            for (int j = i + 2; j <= argc; ++j)
+                argv[j - 2] = argv[j];
+            argc -= 2;
+            break;
+        }
+    }
     if (argc < 2) {
         cerr << "Z-Chaff: Accelerated SAT Solver from Princeton. " << endl;
         cerr << "Copyright 2000-2004, Princeton University." << endl << endl;;
-        cerr << "Usage: "<< argv[0] << " cnf_file [time_limit]" << endl;
+        cerr << "Usage: "<< argv[0] << " [--stats-json file] cnf_file [time_limit]" << endl;
         return 2;
     }
     cout << "Z-Chaff Version: " << SAT_Version(mng) << endl;
@@ -274,6 +284,15 @@ int main(int argc, char ** argv)
 //    SAT_SetRandomness (mng, 10);
 //    SAT_SetRandSeed (mng, -1);
     int result = SAT_Solve(mng);
+    if (stats_json) {
+        FILE * stats = fopen(stats_json, "a");
+        if (stats) {
+            SAT_PrintStatsJSON(mng, stats, 1, result);
+            fclose(stats);
+        }
+        else
+            cerr << "Can't open statistics file " << stats_json << endl;
+    }
     if (result == SATISFIABLE) 
         verify_solution(mng);
     handle_result (mng, result,  argv[1]);
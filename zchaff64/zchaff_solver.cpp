@@ -66,6 +66,7 @@ void CSolver::re_init_stats(void) {
   _stats.num_decisions_vsids          = 0;
   _stats.num_decisions_shrinking      = 0;
   _stats.num_backtracks               = 0;
+  _stats.num_conflicts                = 0;
   _stats.max_dlevel                   = 0;
   _stats.num_implications             = 0;
   _stats.num_restarts                 = 0;
@@ -1060,6 +1061,7 @@ int CSolver::analyze_conflicts(void) {
   assert(_conflict_lits.size() == 0);
   assert(_implication_queue.empty());
   assert(_num_marked == 0);
+  ++_stats.num_conflicts;
   if (dlevel() == 0) {  // already at level 0. Conflict means unsat.
 #ifdef VERIFY_ON
     for (unsigned i = 1; i < variables()->size(); ++i) {
@@ -145,6 +145,7 @@ struct CSolverStats {
   int           shrinking_benefit;
   int           shrinking_cls_length;
   int           num_backtracks;
+  int           num_conflicts;
   int           max_dlevel;
   int           random_seed;
   long64        num_implications;
@@ -331,6 +332,14 @@ class CSolver:public CDatabase {
       return _stats.num_implications;
     }
 
+    inline int num_restarts(void) {
+      return _stats.num_restarts;
+    }
+
+    inline int num_conflicts(void) {
+      return _stats.num_conflicts;
+    }
+
     inline long64 total_bubble_move(void) {
       return _stats.total_bubble_move;
     }